@@ -0,0 +1,20 @@
+/*---------------------------------------------------------------*\
+| CLAB - Command Line Arguments Builder                           |
+|                                                                 |
+| File: clab.cpp                                                  |
+| Description:                                                    |
+|     Compiled mode. Build this file into a library with          |
+|     CLAB_COMPILED defined, and define it in every TU that       |
+|     includes clab.hpp, to compile the members of                |
+|     details/clab_impl.hpp once instead of in every TU.          |
+|                                                                 |
+| Minimum Standard: ISO C++17                                     |
+| License: MIT (c) 2025                                           |
+\*---------------------------------------------------------------*/
+
+#ifndef CLAB_COMPILED
+#error "clab.cpp is only needed with CLAB_COMPILED; header-only builds must not compile it."
+#endif
+
+#include "clab.hpp"
+#include "details/clab_impl.hpp"
@@ -15,20 +15,44 @@
 #include <functional>
 #include <unordered_set>
 #include <unordered_map>
-#include <algorithm>
 #include <initializer_list>
 #include <memory>
+#include <string_view>
+#include <type_traits>
 #include "details/types.hpp"
 #include "details/exceptions.hpp"
 #include "details/evaluation.hpp"
+#include "details/observer.hpp"
+#include "details/usage.hpp"
+#include "details/events.hpp"
+#include "details/index.hpp"
+#include "details/intern.hpp"
+
+/*
+** Compiled mode: with CLAB_COMPILED defined in every TU, the members in details/clab_impl.hpp
+** (building, profiles, the default `evaluate`, `Evaluation::diff`) are only declared here and
+** compiled once by clab.cpp. Without it the library stays header-only.
+*/
+#if defined(CLAB_COMPILED)
+#define CLAB_INLINE
+#else
+#define CLAB_INLINE inline
+#endif
 
 namespace clab {
 
+    class SchemaImage;
+    class ParserGenerator;
+
     class CLAB {
+        friend class SchemaImage; // details/image.hpp
+        friend class ParserGenerator; // details/codegen.hpp
+
     public:
         struct TagInfo {
-            String prefix;
+            uint32_t prefix;        // id in the prefix pool, see prefix_of()
             bool toggle_val;
+            bool shadowed = false; // an earlier flag owns the same full tag
         };
 
         struct FlagConfig {
@@ -40,6 +64,7 @@ namespace clab {
             String id{};
             Action action{};
             size_t consumed_args = 0;
+            size_t slot = 0; // interned id number, shared by flags with the same id
             bool is_required    = false; // from tigger
             bool is_multiple    = false; // from tigger
             bool is_abort       = false; // from tigger
@@ -47,131 +72,291 @@ namespace clab {
             bool default_toggle = false; // defaults
         };
 
+        /** @brief Flag index returned when a token matches no tag. */
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
     private:
-        Vector<Shared<FlagConfig>> flags_vector;
+        Vector<FlagConfig> flags_vector;      // by value, referenced by index
+        Shared<StringPool> id_names = std::make_shared<StringPool>(); // slot -> id, shared with evaluations
+        StringPool prefix_names;              // distinct tag prefixes
+        Shared<UsageCounters> usage_counters; // opt-in, see track_usage()
+        Vector<size_t> scan_order;            // tagged flags by hotness, empty = declaration order
+        bool keep_order = false;              // fill Evaluation::occurrences(), see record_order()
+        PrefixIndex tag_index;                // prefix -> tag -> flag, built by finalize()
+        bool frozen = false;                  // set by finalize(), no more declarations
+        bool dedupe_values = false;           // intern values in each Evaluation, see intern_values()
 
         struct MatchCandidate {
-            Shared<FlagConfig> flag;
+            size_t flag;
             String full_tag;
             bool toggle;
         };
 
-        inline void initialize_defaults(Evaluation& out_eval) const {
-            for(const Shared<FlagConfig>& flag : flags_vector) {
-                out_eval.set_state(flag->id, flag->default_toggle);
-                for(const String& val : flag->default_params)
-                    out_eval.add_param(flag->id, val);
+        /*
+        ** Hot table: the per-flag data the parse loop reads on every token, kept compact and
+        ** in sync with `flags_vector` by the configurator. `FlagConfig` is the cold side (ids,
+        ** defaults, allowed values, actions), only touched to store values or report errors.
+        */
+        enum HotBit : uint8_t {
+            hot_required = 1 << 0,
+            hot_multiple = 1 << 1,
+            hot_abort    = 1 << 2,
+            hot_over     = 1 << 3,
+            hot_default  = 1 << 4, // default toggle
+            hot_tagged   = 1 << 5, // has at least one tag, i.e. not positional
+            hot_allowed  = 1 << 6, // restricted values
+            hot_action   = 1 << 7
+        };
+
+        Vector<uint32_t> hot_consume;
+        Vector<uint32_t> hot_slot;
+        Vector<uint8_t> hot_bits;
+
+        inline bool has(size_t flag_idx, uint8_t bit) const noexcept {
+            return (hot_bits[flag_idx] & bit) != 0;
+        }
+
+        inline void sync_hot(size_t flag_idx) noexcept {
+            const FlagConfig& flag = flags_vector[flag_idx];
+            hot_consume[flag_idx] = static_cast<uint32_t>(flag.consumed_args);
+            hot_slot[flag_idx] = static_cast<uint32_t>(flag.slot);
+            hot_bits[flag_idx] = static_cast<uint8_t>(
+                  (flag.is_required              ? hot_required : 0)
+                | (flag.is_multiple              ? hot_multiple : 0)
+                | (flag.is_abort                 ? hot_abort    : 0)
+                | (flag.is_over                  ? hot_over     : 0)
+                | (flag.default_toggle           ? hot_default  : 0)
+                | (!flag.tags.empty()            ? hot_tagged   : 0)
+                | (!flag.allowed_params.empty()  ? hot_allowed  : 0)
+                | (flag.action                   ? hot_action   : 0));
+        }
+
+        template<class Observer>
+        inline void run_action(const FlagConfig& flag, const String& val, Observer& obs) const {
+            PhaseTimer<Observer> timer(obs, Phase::Actions);
+            flag.action(val);
+        }
+
+        template<class Observer>
+        inline size_t store_value(size_t slot, const String& val, size_t token, Evaluation& eval, Observer& obs) const {
+            if constexpr(Observer::enabled) {
+                PhaseTimer<Observer, HasTokenPhases<Observer>::value> timer(obs, Phase::Store);
+                size_t capacity = eval.list_at(slot).capacity();
+                size_t pooled = eval.value_pool().size();
+                size_t offset = eval.add_param_at(slot, val, token);
+                if(eval.list_at(slot).capacity() != capacity)
+                    obs.value_growth();
+                if(eval.value_pool().size() != pooled && val.size() > String().capacity())
+                    obs.value_growth();
+                obs.value_stored();
+                return offset;
+            } else {
+                return eval.add_param_at(slot, val, token);
+            }
+        }
+
+        inline void log_occurrence(size_t flag_idx, size_t offset, Evaluation& eval) const {
+            if(keep_order)
+                eval.log_occurrence(flag_idx, offset);
+        }
+
+        template<class Observer>
+        inline void initialize_defaults(Evaluation& out_eval, Observer& obs) const {
+            PhaseTimer<Observer> timer(obs, Phase::InitializeDefaults);
+            for(size_t flag_idx = 0; flag_idx < flags_vector.size(); ++flag_idx) {
+                const FlagConfig& flag = flags_vector[flag_idx];
+                out_eval.set_state_at(flag.slot, has(flag_idx, hot_default));
+                for(const String& val : flag.default_params)
+                    store_value(flag.slot, val, ValueList::no_token, out_eval, obs);
             }
         }
 
-        inline bool check_for_abort(const Vector<String>& args, Evaluation& out_eval) const {
+        template<class Observer>
+        inline bool check_for_abort(const Vector<String>& args, Evaluation& out_eval, Observer& obs) const {
+            PhaseTimer<Observer> timer(obs, Phase::CheckForAbort);
             for(const String& arg : args) {
                 bool dummy = false;
-                Shared<FlagConfig> flag = find_match(arg, dummy);
+                size_t flag_idx = find_match(arg, dummy, obs);
 
-                if(!flag || !flag->is_abort)
+                if(flag_idx == npos || !has(flag_idx, hot_abort))
                     continue;
 
-                out_eval.set_aborted_by(flag->id);
-                out_eval.set_state(flag->id, dummy);
+                const FlagConfig& flag = flags_vector[flag_idx];
+                out_eval.set_aborted_by(flag.id);
+                out_eval.set_state_at(flag.slot, dummy);
+                log_occurrence(flag_idx, Evaluation::Occurrence::no_value, out_eval);
 
-                if(flag->action)
-                    flag->action("");
+                if(has(flag_idx, hot_action))
+                    run_action(flag, "", obs);
 
                 return true;
             }
             return false;
         }
 
-        inline void validate_and_store(Shared<FlagConfig> flag, const String& val, Evaluation& eval) const {
-            if(!flag->allowed_params.empty() && flag->allowed_params.find(val) == flag->allowed_params.end())
+        template<class Observer>
+        inline void validate_and_store(size_t flag_idx, const Vector<String>& args, size_t token, Evaluation& eval, Observer& obs) const {
+            const FlagConfig& flag = flags_vector[flag_idx];
+            const String& val = args[token];
+            if(has(flag_idx, hot_allowed) && flag.allowed_params.find(val) == flag.allowed_params.end())
                 throw InvalidValue(val);
 
-            eval.add_param(flag->id, val);
-            if(flag->action)
-                flag->action(val);
+            log_occurrence(flag_idx, store_value(hot_slot[flag_idx], val, token, eval, obs), eval);
+            if(has(flag_idx, hot_action))
+                run_action(flag, val, obs);
         }
 
-        inline void handle_tagged_token(Shared<FlagConfig> flag, bool toggle, const Vector<String>& args,
-            size_t& idx, Evaluation& eval, std::unordered_set<String>& ids) const {
-            bool already_seen = ids.find(flag->id) != ids.end();
-            if(already_seen && !flag->is_multiple)
-                throw RedundantArgument(flag->id);
+        inline void validate(size_t flag_idx, std::string_view val) const {
+            if(!has(flag_idx, hot_allowed))
+                return;
 
-            if(!already_seen && flag->consumed_args > 0 && !flag->is_over)
-                eval.clear_params(flag->id);
+            for(const String& allowed : flags_vector[flag_idx].allowed_params) {
+                if(allowed == val)
+                    return;
+            }
+            throw InvalidValue(String(val));
+        }
 
-            ids.insert(flag->id);
-            eval.set_state(flag->id, toggle);
+        inline void record_usage(size_t flag_idx) const noexcept {
+            if(usage_counters)
+                usage_counters->hit(flag_idx);
+        }
+
+        template<class Observer>
+        inline void handle_tagged_token(size_t flag_idx, bool toggle, const Vector<String>& args,
+            size_t& idx, Evaluation& eval, SeenSet& provided, Observer& obs) const {
+            const String& id = flags_vector[flag_idx].id;
+            const size_t consumed_args = hot_consume[flag_idx];
+            const size_t slot = hot_slot[flag_idx];
+            bool already_seen = provided.set(slot);
+            if(already_seen && !has(flag_idx, hot_multiple))
+                throw RedundantArgument(id);
+
+            if(!already_seen && consumed_args > 0 && !has(flag_idx, hot_over))
+                eval.clear_params_at(slot);
+
+            record_usage(flag_idx);
+            eval.set_state_at(slot, toggle);
             idx++;
 
-            for(size_t i = 0; i < flag->consumed_args; ++i) {
+            if(consumed_args == 0)
+                log_occurrence(flag_idx, Evaluation::Occurrence::no_value, eval);
+
+            for(size_t i = 0; i < consumed_args; ++i) {
                 if(idx >= args.size())
-                    throw MissingValue(flag->id);
+                    throw MissingValue(id);
 
-                String val = args[idx++];
+                const String& val = args[idx];
                 bool d = false;
-                if(find_match(val, d))
+                if(find_match(val, d, obs) != npos)
                     throw TokenMismatch(val);
 
-                validate_and_store(flag, val, eval);
+                validate_and_store(flag_idx, args, idx++, eval, obs);
             }
         }
 
+        template<class Observer>
         inline bool handle_positional_token(const Vector<String>& args, size_t& idx,
-            Evaluation& eval, std::unordered_set<String>& ids) const {
-            for(const Shared<FlagConfig>& flag : flags_vector) {
-                if(!flag->tags.empty())
-                    continue;
+            Evaluation& eval, SeenSet& provided, size_t& positional_cursor, Observer& obs) const {
+            size_t flag_idx = find_positional(provided, positional_cursor);
+            if(flag_idx == npos)
+                return false;
+
+            const String& id = flags_vector[flag_idx].id;
+            const size_t consumed_args = hot_consume[flag_idx];
+            const size_t slot = hot_slot[flag_idx];
+            bool is_first = !provided.set(slot);
+            bool is_multiple = has(flag_idx, hot_multiple);
+
+            if(is_first && (is_multiple || consumed_args > 0) && !has(flag_idx, hot_over))
+                eval.clear_params_at(slot);
+
+            record_usage(flag_idx);
+            eval.set_state_at(slot, true);
+
+            if(is_multiple) {
+                while(idx < args.size()) {
+                    bool d = false;
+                    if(find_match(args[idx], d, obs) != npos)
+                        break;
+                    validate_and_store(flag_idx, args, idx++, eval, obs);
+                }
+            } else {
+                if(consumed_args == 0)
+                    log_occurrence(flag_idx, Evaluation::Occurrence::no_value, eval);
+                for(size_t i = 0; i < consumed_args; ++i) {
+                    if(idx >= args.size())
+                        throw MissingValue(id);
+                    validate_and_store(flag_idx, args, idx++, eval, obs);
+                }
+            }
+            return true;
+        }
 
-                bool is_first = ids.find(flag->id) == ids.end();
-                if(!is_first && !flag->is_multiple)
-                    continue;
+        template<class Observer>
+        inline void verify_required_flags(const SeenSet& provided, Observer& obs) const {
+            PhaseTimer<Observer> timer(obs, Phase::VerifyRequired);
+            for(size_t flag_idx = 0; flag_idx < flags_vector.size(); ++flag_idx) {
+                if(has(flag_idx, hot_required) && !provided.test(hot_slot[flag_idx]))
+                    throw MissingArgument(flags_vector[flag_idx].id);
+            }
+        }
 
-                if(is_first && (flag->is_multiple || flag->consumed_args > 0) && !flag->is_over)
-                    eval.clear_params(flag->id);
+        /*
+        ** @brief First positional still able to take a value, scanning from `cursor` (0 at the start of a parse).
+        ** @note `provided` only grows during a parse, so the answer never moves back: resuming at the
+        **       last answer keeps the scans of a whole parse linear in the number of flags.
+        */
+        inline size_t find_positional(const SeenSet& provided, size_t& cursor) const noexcept {
+            for(; cursor < hot_bits.size(); ++cursor) {
+                uint8_t bits = hot_bits[cursor];
+                if(!(bits & hot_tagged) && ((bits & hot_multiple) || !provided.test(hot_slot[cursor])))
+                    return cursor;
+            }
+            return npos;
+        }
 
-                ids.insert(flag->id);
-                eval.set_state(flag->id, true);
+        inline String full_tag(const String& tag, const TagInfo& info) const {
+            return prefix_names[info.prefix] + tag;
+        }
 
-                if(flag->is_multiple) {
-                    while(idx < args.size()) {
-                        bool d = false;
-                        if(find_match(args[idx], d))
-                            break;
-                        validate_and_store(flag, args[idx++], eval);
-                    }
-                } else {
-                    for(size_t i = 0; i < flag->consumed_args; ++i) {
-                        if(idx >= args.size())
-                            throw MissingValue(flag->id);
-                        validate_and_store(flag, args[idx++], eval);
-                    }
-                }
-                return true;
-            }
-            return false;
+        static inline bool matches_tag(std::string_view arg, const String& prefix, const String& tag) noexcept {
+            return arg.size() == prefix.size() + tag.size()
+                && arg.compare(0, prefix.size(), prefix) == 0
+                && arg.compare(prefix.size(), tag.size(), tag) == 0;
         }
 
-        inline void verify_required_flags(const std::unordered_set<String>& provided_ids) const {
-            for(const Shared<FlagConfig>& flag : flags_vector) {
-                if(flag->is_required && provided_ids.find(flag->id) == provided_ids.end())
-                    throw MissingArgument(flag->id);
+        template<class Observer>
+        inline size_t find_match(std::string_view arg, bool& out_toggle, Observer& obs) const {
+            PhaseTimer<Observer, HasTokenPhases<Observer>::value> timer(obs, Phase::Lookup);
+            obs.tag_lookup();
+            if(frozen) {
+                const TagIndex::Entry* entry = tag_index.find(arg);
+                if(!entry)
+                    return npos;
+                out_toggle = entry->toggle;
+                return entry->flag;
             }
-        }
 
-        inline Shared<FlagConfig> find_match(const String& arg, bool& out_toggle) const {
-            for(const Shared<FlagConfig>& flag : flags_vector) {
-                for(const std::pair<const String, TagInfo>& tag_info : flag->tags) {
-                    if(arg == (tag_info.second.prefix + tag_info.first)) {
+            size_t count = scan_order.empty() ? flags_vector.size() : scan_order.size();
+            for(size_t pos = 0; pos < count; ++pos) {
+                size_t flag_idx = scan_order.empty() ? pos : scan_order[pos];
+                for(const std::pair<const String, TagInfo>& tag_info : flags_vector[flag_idx].tags) {
+                    if(!tag_info.second.shadowed && matches_tag(arg, prefix_names[tag_info.second.prefix], tag_info.first)) {
                         out_toggle = tag_info.second.toggle_val;
-                        return flag;
+                        return flag_idx;
                     }
                 }
             }
-            return nullptr;
+            return npos;
         }
 
+        /*
+        ** @brief Builds the prefix index and freezes the builder (the work of `finalize()`).
+        ** @param validate Throw on duplicated ids or tags; off only for schemas known to be valid.
+        */
+        void build_index(bool validate);
+
     public:
         CLAB() = default;
         /*
@@ -182,119 +367,526 @@ namespace clab {
         }
         ~CLAB() = default;
 
+        /*
+        ** @brief Deep copy: the copy owns its own flags and can be extended or reordered
+        **        without touching the original. Usage counters stay shared.
+        */
+        CLAB(const CLAB&) = default;
+        CLAB& operator=(const CLAB&) = default;
+        CLAB(CLAB&&) = default;
+        CLAB& operator=(CLAB&&) = default;
+
         struct FlagConfigurator {
-            Shared<FlagConfig> data;
             CLAB& parent;
+            size_t index;
+
+            /*
+            ** @brief The flag being configured. The reference is invalidated by the next `start()`.
+            ** @note Read-only: the parse loop reads the hot table, which only the configurator
+            **       methods keep in sync, so every change goes through them.
+            */
+            inline const FlagConfig& data() const noexcept {
+                return parent.flags_vector[index];
+            }
+
+        private:
+            friend class CLAB;
 
-            inline FlagConfigurator& action(FlagConfig::Action fn) noexcept {
-                data->action = std::move(fn);
+            /* Every change goes through here: a finalized builder is shared by readers and its index is built. */
+            inline FlagConfig& config() const {
+                if(parent.frozen)
+                    throw InvalidBuilding("Cannot configure argument '" + data().id + "' after finalize().");
+                return parent.flags_vector[index];
+            }
+
+        public:
+
+            inline FlagConfigurator& action(FlagConfig::Action fn) {
+                config().action = std::move(fn);
+                parent.sync_hot(index);
                 return *this;
             }
 
             inline FlagConfigurator& flag(String tag, String pref = "-") {
-                data->tags[tag] = { pref, true };
+                config().tags[tag] = { parent.prefix_names.intern(pref), true };
+                parent.sync_hot(index);
                 return *this;
             }
 
             inline FlagConfigurator& toggle(bool val, String tag, String pref = "-") {
-                data->tags[tag] = { pref, val };
+                config().tags[tag] = { parent.prefix_names.intern(pref), val };
+                parent.sync_hot(index);
                 return *this;
             }
 
-            inline FlagConfigurator& initial(bool val) noexcept {
-                data->default_toggle = val;
+            inline FlagConfigurator& initial(bool val) {
+                config().default_toggle = val;
+                parent.sync_hot(index);
                 return *this;
             }
 
             inline FlagConfigurator& initial(String val) {
-                data->default_params.clear();
-                data->default_params.push_back(std::move(val));
+                config().default_params.clear();
+                config().default_params.push_back(std::move(val));
+                parent.sync_hot(index);
                 return *this;
             }
 
             inline FlagConfigurator& initial(std::initializer_list<String> vals) {
-                data->default_params = vals;
+                config().default_params = vals;
+                parent.sync_hot(index);
                 return *this;
             }
 
-            inline FlagConfigurator& consume(size_t n) noexcept {
-                data->consumed_args = n;
+            inline FlagConfigurator& consume(size_t n) {
+                config().consumed_args = n;
+                parent.sync_hot(index);
                 return *this;
             }
 
             inline FlagConfigurator& consume(size_t n, std::initializer_list<String> allowed) {
-                data->consumed_args = n;
+                config().consumed_args = n;
                 for(const String& s : allowed)
-                    data->allowed_params.insert(s);
+                    config().allowed_params.insert(s);
+                parent.sync_hot(index);
                 return *this;
             }
 
-            inline FlagConfigurator& required() noexcept {
-                data->is_required = true;
+            inline FlagConfigurator& required() {
+                config().is_required = true;
+                parent.sync_hot(index);
                 return *this;
             }
 
-            inline FlagConfigurator& multiple() noexcept {
-                data->is_multiple = true;
+            inline FlagConfigurator& multiple() {
+                config().is_multiple = true;
+                parent.sync_hot(index);
                 return *this;
             }
 
-            inline FlagConfigurator& abort() noexcept {
-                data->is_abort = true;
+            inline FlagConfigurator& abort() {
+                config().is_abort = true;
+                parent.sync_hot(index);
                 return *this;
             }
 
-            inline FlagConfigurator& over() noexcept {
-                data->is_over = true;
-                data->is_multiple = true;
+            inline FlagConfigurator& over() {
+                config().is_over = true;
+                config().is_multiple = true;
+                parent.sync_hot(index);
                 return *this;
             }
 
             inline CLAB& end() {
-                if(data->tags.empty() && data->is_multiple && data->consumed_args > 0)
-                    throw InvalidBuilding("Positional argument '" + data->id + "' cannot have both .consume() and .multiple().");
+                if(data().tags.empty() && data().is_multiple && data().consumed_args > 0)
+                    throw InvalidBuilding("Positional argument '" + data().id + "' cannot have both .consume() and .multiple().");
                 return parent;
             }
         };
 
-        inline FlagConfigurator start(String id = "") {
-            Shared<FlagConfig> flag = std::make_shared<FlagConfig>();
-            flag->id = id;
-            flags_vector.push_back(flag);
-            return { flag, *this };
+        /*------------------------------*\
+        | Events:                        |
+        | Pull parser over the input.    |
+        | Yields one `Event` per step.   |
+        \*------------------------------*/
+        class Events {
+            enum class Mode { Start, Token, TaggedValues, PositionalValues, PositionalRun, Aborted, Done };
+
+            const CLAB& _parser;
+            TokenView _tokens;
+            SeenSet _seen;
+            Event _current{};
+            Mode _mode = Mode::Start;
+            size_t _idx = 0;
+            size_t _remaining = 0;
+            size_t _positional = 0; // cursor of find_positional
+            bool _aborted = false;
+
+            inline bool is_tag(std::string_view token) const {
+                NullObserver obs;
+                bool d = false;
+                return _parser.find_match(token, d, obs) != npos;
+            }
+
+            inline bool check_for_abort() {
+                NullObserver obs;
+                for(size_t i = 0; i < _tokens.size(); ++i) {
+                    bool toggle = true;
+                    size_t flag_idx = _parser.find_match(_tokens[i], toggle, obs);
+                    if(flag_idx != npos && _parser.has(flag_idx, hot_abort)) {
+                        _current = { flag_idx, toggle, {}, i };
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            inline void emit_value(bool check_tag) {
+                std::string_view val = _tokens[_idx];
+                if(check_tag && is_tag(val))
+                    throw TokenMismatch(String(val));
+
+                _parser.validate(_current.flag, val);
+                _current.value = val;
+                _current.token = _idx++;
+            }
+
+            inline bool start_token() {
+                NullObserver obs;
+                bool toggle = true;
+                size_t flag_idx = _parser.find_match(_tokens[_idx], toggle, obs);
+
+                if(flag_idx != npos) {
+                    if(_seen.set(_parser.hot_slot[flag_idx]) && !_parser.has(flag_idx, hot_multiple))
+                        throw RedundantArgument(_parser.flags_vector[flag_idx].id);
+
+                    _parser.record_usage(flag_idx);
+                    _current = { flag_idx, toggle, {}, _idx++ };
+                    _remaining = _parser.hot_consume[flag_idx];
+                    _mode = Mode::TaggedValues;
+                    return _remaining == 0;
+                }
+
+                flag_idx = _parser.find_positional(_seen, _positional);
+                if(flag_idx == npos)
+                    throw UnexpectedArgument(String(_tokens[_idx]));
+
+                bool is_multiple = _parser.has(flag_idx, hot_multiple);
+                _seen.set(_parser.hot_slot[flag_idx]);
+                _parser.record_usage(flag_idx);
+                _current = { flag_idx, true, {}, _idx };
+                _remaining = _parser.hot_consume[flag_idx];
+                _mode = is_multiple ? Mode::PositionalRun : Mode::PositionalValues;
+                return !is_multiple && _remaining == 0;
+            }
+
+            inline void advance() {
+                for(;;) {
+                    switch(_mode) {
+                        case Mode::Start:
+                            _aborted = check_for_abort();
+                            _mode = _aborted ? Mode::Aborted : Mode::Token;
+                            if(_aborted)
+                                return;
+                            continue;
+
+                        case Mode::Token:
+                            if(_idx >= _tokens.size()) {
+                                _mode = Mode::Done;
+                                NullObserver obs;
+                                _parser.verify_required_flags(_seen, obs);
+                                return;
+                            }
+                            if(start_token())
+                                return;
+                            continue;
+
+                        case Mode::TaggedValues:
+                        case Mode::PositionalValues:
+                            if(_remaining == 0) {
+                                _mode = Mode::Token;
+                                continue;
+                            }
+                            if(_idx >= _tokens.size())
+                                throw MissingValue(_parser.flags_vector[_current.flag].id);
+                            emit_value(_mode == Mode::TaggedValues);
+                            _remaining--;
+                            return;
+
+                        case Mode::PositionalRun:
+                            if(_idx < _tokens.size() && !is_tag(_tokens[_idx])) {
+                                emit_value(false);
+                                return;
+                            }
+                            _mode = Mode::Token;
+                            continue;
+
+                        case Mode::Aborted:
+                        case Mode::Done:
+                            _mode = Mode::Done;
+                            return;
+                    }
+                }
+            }
+
+        public:
+            struct Sentinel {};
+
+            class Iterator {
+                Events* _events;
+
+            public:
+                explicit Iterator(Events* events) noexcept : _events(events) {}
+
+                inline const Event& operator*() const noexcept { return _events->_current; }
+                inline const Event* operator->() const noexcept { return &_events->_current; }
+
+                inline Iterator& operator++() {
+                    _events->advance();
+                    return *this;
+                }
+
+                inline bool operator==(Sentinel) const noexcept { return _events->_mode == Mode::Done; }
+                inline bool operator!=(Sentinel) const noexcept { return _events->_mode != Mode::Done; }
+            };
+
+            Events(const CLAB& parser, TokenView tokens)
+                : _parser(parser), _tokens(tokens), _seen(parser.id_names->size()) {}
+
+            /*
+            ** @brief Rewinds to parse `tokens` from the start, keeping the seen-set storage.
+            ** @note Reusing one `Events` this way allocates nothing, whatever the schema size.
+            */
+            inline void reset(TokenView tokens) {
+                _tokens = tokens;
+                _seen.reset(_parser.id_names->size());
+                _current = {};
+                _mode = Mode::Start;
+                _idx = 0;
+                _remaining = 0;
+                _positional = 0;
+                _aborted = false;
+            }
+
+            /** @brief Starts the parse (abort pre-scan and first event). Call once. */
+            inline Iterator begin() {
+                if(_mode == Mode::Start)
+                    advance();
+                return Iterator(this);
+            }
+
+            inline Sentinel end() const noexcept {
+                return {};
+            }
+
+            /** @brief True if the only event is an abort flag found by the pre-scan. */
+            inline bool aborted() const noexcept {
+                return _aborted;
+            }
+        };
+
+        FlagConfigurator start(String id = "");
+
+        /*
+        ** @brief `start(F::id)` for a typed id, so `Evaluation::get<F>()` reads its slot directly.
+        ** @throws InvalidBuilding if `F::id` doesn't get the slot of `F` in its `Schema`: ids are
+        **         numbered in the order they're first declared, typed or not, so typed ids are declared
+        **         first, in schema order.
+        */
+        template<class F>
+        inline FlagConfigurator start() {
+            static_assert(std::is_base_of_v<FlagIdBase, F>, "start<F>() needs a clab::FlagId type");
+            static_assert(F::schema::template contains<F>, "start<F>(): F is not listed in its schema");
+            String id = F::id;
+            uint32_t slot = id_names->find(id);
+            size_t expected = slot == StringPool::npos ? id_names->size() : slot;
+            if(expected != flag_slot<F>)
+                throw InvalidBuilding("Argument '" + id + "' is listed at slot " + std::to_string(flag_slot<F>)
+                    + " of its schema but declared as slot " + std::to_string(expected) + ".");
+            return start(std::move(id));
         }
 
-        inline Evaluation evaluate(int argc, char* argv[]) const {
+        /*
+        ** @brief Appends copies of every flag of `other`, after the flags of this builder.
+        ** @throws InvalidBuilding if `other` reuses an id or a full tag (`prefix + tag`) of this
+        **         builder. Nothing is appended in that case.
+        */
+        CLAB& merge(const CLAB& other);
+
+        /*
+        ** @brief Validates the whole schema, builds the tag index and freezes the builder.
+        ** @note After this, `evaluate` strips the prefix of a token once and resolves the rest
+        **       with one hash lookup in that prefix's table; `start` throws.
+        ** @throws InvalidBuilding on a duplicated id, a duplicated tag, or two different
+        **         `prefix + tag` pairs spelling the same token (e.g. `-` + `-x` and `--` + `x`).
+        */
+        inline CLAB& finalize() {
+            build_index(true);
+            return *this;
+        }
+
+        /** @brief Drops the tag index so arguments can be declared again. */
+        inline CLAB& unfreeze() noexcept {
+            tag_index.clear();
+            frozen = false;
+            return *this;
+        }
+
+        inline bool is_finalized() const noexcept {
+            return frozen;
+        }
+
+        /*
+        ** @brief Enables (or disables) per-flag hit counters.
+        ** @note Counters are relaxed atomics, one cache line each; concurrent `evaluate` calls are safe.
+        */
+        CLAB& track_usage(bool enable = true);
+
+        /*
+        ** @brief Returns `(id, hits)` for every flag, in declaration order.
+        ** @note Empty when usage tracking is disabled.
+        */
+        Vector<std::pair<String, uint64_t>> usage() const;
+
+        /*
+        ** @brief Makes `evaluate` log every occurrence, in input order, into `Evaluation::occurrences()`.
+        */
+        inline CLAB& record_order(bool enable = true) noexcept {
+            keep_order = enable;
+            return *this;
+        }
+
+        /** @brief Returns the prefix a tag was declared with. */
+        inline const String& prefix_of(const TagInfo& info) const noexcept {
+            return prefix_names[info.prefix];
+        }
+
+        /*
+        ** @brief Makes each `Evaluation` store a repeated value once (e.g. `--env prod` given many times).
+        ** @note Costs one hash per stored value, saves the copy of every repeat.
+        */
+        inline CLAB& intern_values(bool enable = true) noexcept {
+            dedupe_values = enable;
+            return *this;
+        }
+
+        /** @brief Returns the id of the flag at `flag_idx` (declaration order). */
+        inline const String& id_of(size_t flag_idx) const {
+            return flags_vector.at(flag_idx).id;
+        }
+
+        /** @brief Returns the configuration of the flag at `flag_idx` (declaration order). */
+        inline const FlagConfig& flag_config(size_t flag_idx) const {
+            return flags_vector.at(flag_idx);
+        }
+
+        /** @brief Zeroes every usage counter. */
+        inline void reset_usage() noexcept {
+            if(usage_counters)
+                usage_counters->reset();
+        }
+
+        /*
+        ** @brief Reorders the tag scan so the most used flags are tried first.
+        ** @note Results are unchanged: when two flags share a full tag the first declared still wins.
+        ** @note On a finalized builder the scan is not used: the tag index is rebuilt instead, inserting
+        **       the most used tags first so they sit in their home bucket. `finalize()` does the same
+        **       with the hits recorded so far.
+        ** @note Must not run concurrently with `evaluate`. Declaring a new flag restores declaration order.
+        */
+        CLAB& optimize_order();
+
+        /** @brief Drops any adaptive ordering and scans flags in declaration order again. */
+        CLAB& restore_order();
+
+        /*
+        ** @brief Writes the usage counters as a profile (`id<TAB>hits` per line).
+        ** @return false if usage tracking is disabled or the file can't be written.
+        */
+        bool save_profile(const String& path) const;
+
+        /*
+        ** @brief Adds the hits of a saved profile to the usage counters and reorders the scan.
+        ** @note Enables usage tracking. Unknown ids are ignored.
+        ** @return false if the file can't be read.
+        */
+        bool load_profile(const String& path);
+
+        Evaluation evaluate(int argc, char* argv[]) const;
+
+        /*
+        ** @brief Parses `args` into a new `Evaluation`.
+        ** @note The evaluation shares the interned ids of the builder: one atomic increment per call,
+        **       and its decrement when the evaluation dies. Nothing else in the parse touches a
+        **       reference count; `evaluate(args, out)` skips this one too.
+        */
+        Evaluation evaluate(const Vector<String>& args) const;
+
+        /*
+        ** @brief Parses `args` into `out`, reusing its storage instead of building a new `Evaluation`.
+        ** @note Same results and errors as `evaluate(args)`. Once `out` has grown to fit the inputs
+        **       it sees, this allocates nothing. After an error `out` holds a partial parse.
+        */
+        void evaluate(const Vector<String>& args, Evaluation& out) const;
+
+        /*
+        ** @brief Iterates the parse as events instead of building an `Evaluation`.
+        ** @note Same matching and validation as `evaluate`, errors are thrown when reached.
+        ** @note Defaults and actions are not applied. No heap allocation for schemas of up to
+        **       `SeenSet::inline_bits` ids; beyond that, one per call unless an `Events` is reused
+        **       with `Events::reset`. `args` must outlive the loop.
+        */
+        inline Events events(const Vector<String>& args) const {
+            return Events(*this, TokenView(args));
+        }
+
+        inline Events events(int argc, char* argv[]) const {
+            return Events(*this, TokenView(argc, argv));
+        }
+
+        /*
+        ** @brief Same as `evaluate(argc, argv)`, reporting phases and counters to `obs`.
+        */
+        template<class Observer>
+        inline Evaluation evaluate(int argc, char* argv[], Observer& obs) const {
             Vector<String> args;
+            args.reserve(argc > 0 ? static_cast<size_t>(argc) : 0);
             for(int i = 0; i < argc; ++i)
                 args.push_back(String(argv[i]));
-            return evaluate(args);
+            return evaluate(args, obs);
+        }
+
+        /*
+        ** @brief Same as `evaluate(args)`, reporting phases and counters to `obs`.
+        ** @note `NullObserver` (the default) compiles every hook away.
+        */
+        template<class Observer>
+        inline Evaluation evaluate(const Vector<String>& args, Observer& obs) const {
+            Evaluation eval(id_names, dedupe_values);
+            evaluate(args, eval, obs);
+            return eval;
         }
 
-        inline Evaluation evaluate(const Vector<String>& args) const {
-            Evaluation eval;
-            std::unordered_set<String> user_provided_ids;
+        /*
+        ** @brief Same as `evaluate(args, out)`, reporting phases and counters to `obs`.
+        */
+        template<class Observer>
+        inline void evaluate(const Vector<String>& args, Evaluation& eval, Observer& obs) const {
             size_t arg_idx = 0;
+            size_t positional_cursor = 0;
 
-            initialize_defaults(eval);
+            eval.reset(id_names, dedupe_values);
+            SeenSet& user_provided_ids = eval.provided_scratch(id_names->size());
+            eval.reserve_values(args.size());
 
-            if(check_for_abort(args, eval))
-                return eval;
+            if(keep_order)
+                eval.reserve_occurrences(args.size());
 
-            while(arg_idx < args.size()) {
-                bool toggle_val = true;
-                Shared<FlagConfig> matched_flag = find_match(args[arg_idx], toggle_val);
+            initialize_defaults(eval, obs);
 
-                if(matched_flag) {
-                    handle_tagged_token(matched_flag, toggle_val, args, arg_idx, eval, user_provided_ids);
-                } else if(!handle_positional_token(args, arg_idx, eval, user_provided_ids)) {
-                    throw UnexpectedArgument(args[arg_idx]);
+            if(check_for_abort(args, eval, obs))
+                return;
+
+            {
+                PhaseTimer<Observer> timer(obs, Phase::TokenLoop);
+                while(arg_idx < args.size()) {
+                    bool toggle_val = true;
+                    size_t matched_flag = find_match(args[arg_idx], toggle_val, obs);
+
+                    if(matched_flag != npos) {
+                        handle_tagged_token(matched_flag, toggle_val, args, arg_idx, eval, user_provided_ids, obs);
+                    } else if(!handle_positional_token(args, arg_idx, eval, user_provided_ids, positional_cursor, obs)) {
+                        throw UnexpectedArgument(args[arg_idx]);
+                    }
                 }
             }
 
-            verify_required_flags(user_provided_ids);
-            return eval;
+            verify_required_flags(user_provided_ids, obs);
         }
     };
 
-} // namespace clab
\ No newline at end of file
+} // namespace clab
+
+#if !defined(CLAB_COMPILED)
+#include "details/clab_impl.hpp"
+#endif
\ No newline at end of file
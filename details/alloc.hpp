@@ -0,0 +1,124 @@
+/*---------------------------------------------------------------*\
+| CLAB - Command Line Arguments Builder                           |
+|                                                                 |
+| File: alloc.hpp                                                 |
+| Description:                                                    |
+|     Allocation counting. Replaces the global operator new and   |
+|     delete with counting versions, to check allocation budgets  |
+|     of `evaluate` in tests. Opt-in: define                      |
+|     CLAB_COUNT_ALLOCATIONS in exactly one TU before including.  |
+|                                                                 |
+| Minimum Standard: ISO C++17                                     |
+| License: MIT (c) 2025                                           |
+\*---------------------------------------------------------------*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace clab {
+
+    /*------------------------------*\
+    | AllocationCounts:              |
+    | Heap calls and bytes requested |
+    | by the calling thread.         |
+    \*------------------------------*/
+    struct AllocationCounts {
+        uint64_t allocations = 0;
+        uint64_t deallocations = 0;
+        uint64_t bytes = 0;
+
+        inline AllocationCounts operator-(const AllocationCounts& o) const noexcept {
+            return { allocations - o.allocations, deallocations - o.deallocations, bytes - o.bytes };
+        }
+    };
+
+    /** @brief Running totals of the calling thread; all zero unless the counting operators are linked in. */
+    inline AllocationCounts& thread_allocations() noexcept {
+        static thread_local AllocationCounts counts;
+        return counts;
+    }
+
+    /*------------------------------*\
+    | AllocationScope:               |
+    | Counts what the calling thread |
+    | allocates while it lives.      |
+    \*------------------------------*/
+    class AllocationScope {
+        AllocationCounts _start;
+
+    public:
+        AllocationScope() noexcept : _start(thread_allocations()) {}
+
+        inline AllocationCounts counts() const noexcept {
+            return thread_allocations() - _start;
+        }
+    };
+
+    /*
+    ** @brief Runs `fn()` and returns what it allocated on the calling thread.
+    ** @note E.g. `allocations_of([&] { parser.evaluate(args, eval); }).allocations <= budget` in a test.
+    */
+    template<class Fn>
+    inline AllocationCounts allocations_of(Fn&& fn) {
+        AllocationScope scope;
+        fn();
+        return scope.counts();
+    }
+
+    namespace detail {
+
+        inline void* counted_alloc(std::size_t size, std::size_t align) noexcept {
+            AllocationCounts& counts = thread_allocations();
+            counts.allocations++;
+            counts.bytes += size;
+
+            if(size == 0)
+                size = 1;
+            if(align <= alignof(std::max_align_t))
+                return std::malloc(size);
+
+            size = (size + align - 1) / align * align; // aligned_alloc wants a multiple of the alignment
+            return std::aligned_alloc(align, size);
+        }
+
+        inline void counted_free(void* p) noexcept {
+            if(!p)
+                return;
+            thread_allocations().deallocations++;
+            std::free(p);
+        }
+
+        inline void* counted_alloc_or_throw(std::size_t size, std::size_t align) {
+            void* p = counted_alloc(size, align);
+            if(!p)
+                throw std::bad_alloc();
+            return p;
+        }
+
+    } // namespace detail
+
+} // namespace clab
+
+#if defined(CLAB_COUNT_ALLOCATIONS)
+
+void* operator new(std::size_t size) { return clab::detail::counted_alloc_or_throw(size, 0); }
+void* operator new[](std::size_t size) { return clab::detail::counted_alloc_or_throw(size, 0); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return clab::detail::counted_alloc(size, 0); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return clab::detail::counted_alloc(size, 0); }
+void* operator new(std::size_t size, std::align_val_t align) { return clab::detail::counted_alloc_or_throw(size, static_cast<std::size_t>(align)); }
+void* operator new[](std::size_t size, std::align_val_t align) { return clab::detail::counted_alloc_or_throw(size, static_cast<std::size_t>(align)); }
+
+void operator delete(void* p) noexcept { clab::detail::counted_free(p); }
+void operator delete[](void* p) noexcept { clab::detail::counted_free(p); }
+void operator delete(void* p, std::size_t) noexcept { clab::detail::counted_free(p); }
+void operator delete[](void* p, std::size_t) noexcept { clab::detail::counted_free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { clab::detail::counted_free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { clab::detail::counted_free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { clab::detail::counted_free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { clab::detail::counted_free(p); }
+
+#endif
@@ -0,0 +1,168 @@
+/*---------------------------------------------------------------*\
+| CLAB - Command Line Arguments Builder                           |
+|                                                                 |
+| File: binding.hpp                                               |
+| Description:                                                    |
+|     Struct binding. Declares one flag per member of a config    |
+|     struct and writes parsed values straight into the members,  |
+|     with the struct's initializers as defaults.                 |
+|     Opt-in: include this header explicitly.                     |
+|                                                                 |
+| Minimum Standard: ISO C++17                                     |
+| License: MIT (c) 2025                                           |
+\*---------------------------------------------------------------*/
+
+#pragma once
+
+#include <charconv>
+#include <cstdlib>
+#include <initializer_list>
+#include <type_traits>
+#include "../clab.hpp"
+
+namespace clab {
+
+    /*------------------------------*\
+    | Binding:                       |
+    | A schema plus one writer per   |
+    | flag, fed by the event parser. |
+    \*------------------------------*/
+    template<class Struct>
+    class Binding {
+        using Writer = void (*)(Struct&, const Event&, bool first);
+
+        CLAB _schema;
+        Vector<Writer> _writers; // by flag index
+
+        template<auto Member>
+        static void write(Struct& out, const Event& ev, bool first) {
+            using T = std::remove_reference_t<decltype(out.*Member)>;
+            T& field = out.*Member;
+
+            if constexpr(std::is_same_v<T, bool>) {
+                field = ev.toggle;
+            } else if constexpr(std::is_same_v<T, String>) {
+                field.assign(ev.value.data(), ev.value.size());
+            } else if constexpr(std::is_same_v<T, Vector<String>>) {
+                if(first)
+                    field.clear(); // the first occurrence replaces the initializer, like `evaluate`
+                field.emplace_back(ev.value);
+            } else if constexpr(std::is_integral_v<T>) {
+                const char* end = ev.value.data() + ev.value.size();
+                std::from_chars_result res = std::from_chars(ev.value.data(), end, field);
+                if(ev.value.empty() || res.ec != std::errc() || res.ptr != end)
+                    throw InvalidValue(String(ev.value));
+            } else {
+                static_assert(std::is_floating_point_v<T>, "bound members must be bool, String, Vector<String> or arithmetic");
+                String text(ev.value);
+                char* end = nullptr;
+                long double v = std::strtold(text.c_str(), &end);
+                if(text.empty() || end != text.c_str() + text.size())
+                    throw InvalidValue(text);
+                field = static_cast<T>(v);
+            }
+        }
+
+    public:
+        /*
+        ** @brief Declares the flag `id` bound to `Member`.
+        ** @param tags Full tags; leading dashes are the prefix (`"--input"` is `flag("input", "--")`).
+        **             No tags makes a positional.
+        ** @note `bool` members take the state of the flag. `Vector<String>` members take every value
+        **       (`multiple()`), others take one value (`consume(1)`); arithmetic members are parsed and
+        **       throw `InvalidValue` when they don't convert.
+        ** @return The configurator, to add e.g. `required()`; call `end()` as usual.
+        */
+        template<auto Member>
+        inline CLAB::FlagConfigurator field(String id, std::initializer_list<const char*> tags = {}) {
+            using T = std::remove_reference_t<decltype(std::declval<Struct&>().*Member)>;
+
+            CLAB::FlagConfigurator flag = _schema.start(std::move(id));
+            for(const char* tag : tags) {
+                String full = tag;
+                size_t dashes = full.find_first_not_of('-');
+                if(dashes == String::npos)
+                    dashes = 0;
+                flag.flag(full.substr(dashes), full.substr(0, dashes));
+            }
+
+            if constexpr(std::is_same_v<T, Vector<String>>) {
+                if(tags.size() > 0)
+                    flag.consume(1);
+                flag.multiple();
+            } else if constexpr(!std::is_same_v<T, bool>) {
+                flag.consume(1);
+            }
+
+            _writers.resize(flag.index + 1, nullptr);
+            _writers[flag.index] = &Binding::write<Member>;
+            return flag;
+        }
+
+        /** @brief Finalizes the schema (see `CLAB::finalize()`). */
+        inline Binding& finalize() {
+            _schema.finalize();
+            return *this;
+        }
+
+        inline const CLAB& schema() const noexcept {
+            return _schema;
+        }
+
+        /*
+        ** @brief Parses `tokens` straight into `out`: no `Evaluation`, no id lookups.
+        ** @note Same matching, validation and errors as `evaluate`; members that aren't given keep
+        **       their value. On an error `out` may be partly written.
+        */
+        inline void fill(Struct& out, TokenView tokens) const {
+            SeenSet written(_writers.size());
+            for(const Event& ev : CLAB::Events(_schema, tokens)) {
+                if(ev.flag >= _writers.size() || !_writers[ev.flag])
+                    continue;
+                bool first = !written.set(ev.flag) && !_schema.flag_config(ev.flag).is_over;
+                _writers[ev.flag](out, ev, first);
+            }
+        }
+
+        /** @brief Returns a default-initialized `Struct` filled from `args`. */
+        inline Struct parse(const Vector<String>& args) const {
+            Struct out{};
+            fill(out, TokenView(args));
+            return out;
+        }
+
+        inline Struct parse(int argc, char* argv[]) const {
+            Struct out{};
+            fill(out, TokenView(argc, argv));
+            return out;
+        }
+    };
+
+} // namespace clab
+
+/*
+** Builds a finalized `clab::Binding<Type>` from an X-macro listing `X(member, tags...)`:
+**
+**     #define CONFIG_FIELDS(X)            \
+**         X(input,   "-i", "--input")     \
+**         X(verbose, "-v")                \
+**         X(files)
+**
+**     static const auto binding = CLAB_BINDING(Config, CONFIG_FIELDS);
+**     Config config = binding.parse(argc, argv);
+**
+** Each member is declared with its own name as id.
+*/
+#define CLAB_BIND_FIELD(...) CLAB_BIND_FIELD_I(__VA_ARGS__, ) // keeps `X(member)` valid before C++20
+
+#define CLAB_BIND_FIELD_I(member, ...) \
+    clab_binding.template field<&clab_bound_type::member>(#member, { __VA_ARGS__ }).end();
+
+#define CLAB_BINDING(Type, FIELDS) \
+    ([] { \
+        using clab_bound_type = Type; \
+        ::clab::Binding<clab_bound_type> clab_binding; \
+        FIELDS(CLAB_BIND_FIELD) \
+        clab_binding.finalize(); \
+        return clab_binding; \
+    }())
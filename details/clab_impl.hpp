@@ -0,0 +1,256 @@
+/*---------------------------------------------------------------*\
+| CLAB - Command Line Arguments Builder                           |
+|                                                                 |
+| File: clab_impl.hpp                                             |
+| Description:                                                    |
+|     Out-of-line members of CLAB: building, profiles and the     |
+|     default `evaluate`, plus `Evaluation::diff`. Included by    |
+|     clab.hpp in header-only mode, compiled once by clab.cpp     |
+|     with CLAB_COMPILED.                                         |
+|                                                                 |
+| Minimum Standard: ISO C++17                                     |
+| License: MIT (c) 2025                                           |
+\*---------------------------------------------------------------*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include "../clab.hpp"
+
+namespace clab {
+
+    CLAB_INLINE Vector<Evaluation::Change> Evaluation::diff(const Evaluation& other) const {
+        static const Slot absent;
+        Vector<Change> changes;
+
+        auto compare = [&](const String& id, const Slot& a, const Slot& b) {
+            Change c{ id, a.state != b.state,
+                a.values.size() != b.values.size() || a.fingerprint != b.fingerprint };
+            if(c.state || c.values)
+                changes.push_back(std::move(c));
+        };
+
+        for(size_t slot = 0; slot < _slots.size(); ++slot) {
+            const String& id = id_at(slot);
+            size_t theirs = other.slot_of(id);
+            compare(id, _slots[slot], theirs == npos ? absent : other._slots[theirs]);
+        }
+        for(size_t slot = 0; slot < other._slots.size(); ++slot) {
+            const String& id = other.id_at(slot);
+            if(slot_of(id) == npos)
+                compare(id, absent, other._slots[slot]);
+        }
+
+        std::sort(changes.begin(), changes.end(), [](const Change& a, const Change& b) { return a.id < b.id; });
+        return changes;
+    }
+
+    CLAB_INLINE CLAB::FlagConfigurator CLAB::start(String id) {
+        if(frozen)
+            throw InvalidBuilding("Cannot declare argument '" + id + "' after finalize().");
+
+        if(!scan_order.empty())
+            restore_order();
+
+        if(id_names.use_count() > 1 && id_names->find(id) == StringPool::npos)
+            id_names = std::make_shared<StringPool>(*id_names); // evaluations or copies still read the old one
+
+        FlagConfig& flag = flags_vector.emplace_back();
+        flag.slot = id_names->intern(id);
+        flag.id = id;
+        hot_consume.push_back(0);
+        hot_slot.push_back(0);
+        hot_bits.push_back(0);
+        sync_hot(flags_vector.size() - 1);
+        if(usage_counters)
+            usage_counters = usage_counters->grown(flags_vector.size());
+        return { *this, flags_vector.size() - 1 };
+    }
+
+    CLAB_INLINE CLAB& CLAB::merge(const CLAB& other) {
+        std::unordered_set<String> full_tags;
+        for(const FlagConfig& flag : flags_vector) {
+            for(const std::pair<const String, TagInfo>& tag_info : flag.tags)
+                full_tags.insert(full_tag(tag_info.first, tag_info.second));
+        }
+
+        for(const FlagConfig& flag : other.flags_vector) {
+            if(id_names->find(flag.id) != StringPool::npos)
+                throw InvalidBuilding("Duplicate argument id '" + flag.id + "'.");
+            for(const std::pair<const String, TagInfo>& tag_info : flag.tags) {
+                String tag = other.full_tag(tag_info.first, tag_info.second);
+                if(full_tags.find(tag) != full_tags.end())
+                    throw InvalidBuilding("Duplicate tag '" + tag + "' in argument '" + flag.id + "'.");
+            }
+        }
+
+        for(const FlagConfig& flag : other.flags_vector) {
+            FlagConfigurator added = start(flag.id);
+            FlagConfig& data = added.config();
+            size_t slot = data.slot;
+            data = flag;
+            data.slot = slot;
+            for(std::pair<const String, TagInfo>& tag_info : data.tags) {
+                tag_info.second.prefix = prefix_names.intern(other.prefix_names[tag_info.second.prefix]);
+                tag_info.second.shadowed = false;
+            }
+            sync_hot(added.index);
+        }
+        return *this;
+    }
+
+    CLAB_INLINE void CLAB::build_index(bool validate) {
+        if(validate) {
+            TagIndex full_tags; // catches different prefix + tag pairs spelling the same token
+            SeenSet ids(id_names->size());
+
+            for(size_t flag_idx = 0; flag_idx < flags_vector.size(); ++flag_idx) {
+                const FlagConfig& flag = flags_vector[flag_idx];
+                if(ids.set(flag.slot))
+                    throw InvalidBuilding("Duplicate argument id '" + flag.id + "'.");
+
+                for(const std::pair<const String, TagInfo>& tag_info : flag.tags) {
+                    String full = full_tag(tag_info.first, tag_info.second);
+                    const TagIndex::Entry* clash = full_tags.insert(full, flag_idx, tag_info.second.toggle_val);
+                    if(!clash)
+                        continue;
+
+                    const FlagConfig& owner = flags_vector[clash->flag];
+                    auto same = owner.tags.find(tag_info.first);
+                    if(same != owner.tags.end() && same->second.prefix == tag_info.second.prefix)
+                        throw InvalidBuilding("Duplicate tag '" + full + "' in arguments '" + owner.id + "' and '" + flag.id + "'.");
+                    throw InvalidBuilding("Ambiguous tag '" + full + "' in arguments '" + owner.id + "' and '" + flag.id + "': prefixes overlap.");
+                }
+            }
+        }
+
+        // hottest flags first: linear probing gives the first inserted keys their home bucket
+        Vector<size_t> order(flags_vector.size());
+        for(size_t i = 0; i < order.size(); ++i)
+            order[i] = i;
+        if(usage_counters) {
+            std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+                return usage_counters->hits(a) > usage_counters->hits(b);
+            });
+        }
+
+        PrefixIndex index;
+        for(size_t flag_idx : order) {
+            for(const std::pair<const String, TagInfo>& tag_info : flags_vector[flag_idx].tags)
+                index.group(prefix_of(tag_info.second)).insert(tag_info.first, flag_idx, tag_info.second.toggle_val);
+        }
+
+        tag_index = std::move(index);
+        frozen = true;
+    }
+
+    CLAB_INLINE CLAB& CLAB::track_usage(bool enable) {
+        if(!enable)
+            usage_counters.reset();
+        else if(!usage_counters)
+            usage_counters = std::make_shared<UsageCounters>(flags_vector.size());
+        return *this;
+    }
+
+    CLAB_INLINE Vector<std::pair<String, uint64_t>> CLAB::usage() const {
+        Vector<std::pair<String, uint64_t>> out;
+        if(!usage_counters)
+            return out;
+
+        for(size_t i = 0; i < flags_vector.size(); ++i)
+            out.emplace_back(flags_vector[i].id, usage_counters->hits(i));
+        return out;
+    }
+
+    CLAB_INLINE CLAB& CLAB::optimize_order() {
+        restore_order();
+        if(!usage_counters)
+            return *this;
+
+        for(size_t i = 0; i < flags_vector.size(); ++i) {
+            if(!flags_vector[i].tags.empty())
+                scan_order.push_back(i);
+        }
+
+        std::stable_sort(scan_order.begin(), scan_order.end(), [this](size_t a, size_t b) {
+            return usage_counters->hits(a) > usage_counters->hits(b);
+        });
+
+        std::unordered_set<String> owned;
+        for(FlagConfig& flag : flags_vector) {
+            for(std::pair<const String, TagInfo>& tag_info : flag.tags)
+                tag_info.second.shadowed = !owned.insert(full_tag(tag_info.first, tag_info.second)).second;
+        }
+
+        if(frozen)
+            build_index(false); // validated by finalize(): only the bucket layout changes
+        return *this;
+    }
+
+    CLAB_INLINE CLAB& CLAB::restore_order() {
+        scan_order.clear();
+        for(FlagConfig& flag : flags_vector) {
+            for(std::pair<const String, TagInfo>& tag_info : flag.tags)
+                tag_info.second.shadowed = false;
+        }
+        return *this;
+    }
+
+    CLAB_INLINE bool CLAB::save_profile(const String& path) const {
+        if(!usage_counters)
+            return false;
+
+        std::ofstream file(path);
+        if(!file)
+            return false;
+
+        file << "# clab-profile 1\n";
+        for(const std::pair<String, uint64_t>& entry : usage())
+            file << entry.first << '\t' << entry.second << '\n';
+        return static_cast<bool>(file);
+    }
+
+    CLAB_INLINE bool CLAB::load_profile(const String& path) {
+        std::ifstream file(path);
+        if(!file)
+            return false;
+
+        track_usage();
+        String line;
+        while(std::getline(file, line)) {
+            size_t tab = line.rfind('\t');
+            if(line.empty() || line[0] == '#' || tab == String::npos)
+                continue;
+
+            String id = line.substr(0, tab);
+            uint64_t hits = std::strtoull(line.c_str() + tab + 1, nullptr, 10);
+            for(size_t i = 0; i < flags_vector.size(); ++i) {
+                if(flags_vector[i].id == id) {
+                    usage_counters->add(i, hits);
+                    break;
+                }
+            }
+        }
+
+        optimize_order();
+        return true;
+    }
+
+    CLAB_INLINE Evaluation CLAB::evaluate(int argc, char* argv[]) const {
+        NullObserver obs;
+        return evaluate(argc, argv, obs);
+    }
+
+    CLAB_INLINE Evaluation CLAB::evaluate(const Vector<String>& args) const {
+        NullObserver obs;
+        return evaluate(args, obs);
+    }
+
+    CLAB_INLINE void CLAB::evaluate(const Vector<String>& args, Evaluation& out) const {
+        NullObserver obs;
+        evaluate(args, out, obs);
+    }
+
+} // namespace clab
@@ -0,0 +1,452 @@
+/*---------------------------------------------------------------*\
+| CLAB - Command Line Arguments Builder                           |
+|                                                                 |
+| File: codegen.hpp                                               |
+| Description:                                                    |
+|     Parser generator. Writes a header with a parser specialized |
+|     for one schema: typed result fields, a switch-based tag     |
+|     matcher and inlined validation, with the same results and   |
+|     errors as `CLAB::evaluate`.                                 |
+|     Opt-in: include this header explicitly (offline tools).     |
+|                                                                 |
+| Minimum Standard: ISO C++17                                     |
+| License: MIT (c) 2025                                           |
+\*---------------------------------------------------------------*/
+
+#pragma once
+
+#include <cctype>
+#include <fstream>
+#include <map>
+#include <ostream>
+#include <set>
+#include "../clab.hpp"
+
+namespace clab {
+
+    /*------------------------------*\
+    | ParserGenerator:               |
+    | Emits `parse(args)` returning  |
+    | a plain `Result` struct.       |
+    \*------------------------------*/
+    class ParserGenerator {
+    public:
+        struct Options {
+            String name_space = "cli";                        // namespace of the generated code
+            String exceptions_header = "details/exceptions.hpp"; // how the generated header includes clab's exceptions
+        };
+
+    private:
+        struct Field {
+            String id;
+            String name;            // C++ identifier
+            bool state = false;     // default state
+            bool has_values = false;
+            Vector<String> defaults{};
+        };
+
+        struct Tag {
+            size_t flag;
+            bool toggle;
+        };
+
+        const CLAB& _schema;
+        std::ostream& _out;
+        const Options& _options;
+        Vector<Field> _fields;           // by slot
+        std::map<String, Tag> _tags;     // full tag -> first declared owner
+
+        static inline String literal(std::string_view s) {
+            static const char digits[] = "01234567";
+            String out = "\"";
+            for(unsigned char c : s) {
+                if(c == '"' || c == '\\') {
+                    out += '\\';
+                    out += static_cast<char>(c);
+                } else if(c < 0x20 || c >= 0x7F) {
+                    out += '\\';
+                    out += digits[(c >> 6) & 7];
+                    out += digits[(c >> 3) & 7];
+                    out += digits[c & 7];
+                } else {
+                    out += static_cast<char>(c);
+                }
+            }
+            return out + "\"";
+        }
+
+        static inline String label(unsigned c) {
+            if(c > 0x20 && c < 0x7F && c != '\'' && c != '\\')
+                return String("'") + static_cast<char>(c) + "'";
+            return std::to_string(c);
+        }
+
+        static inline bool reserved(const String& name) {
+            static const std::set<String> words = {
+                "alignas", "alignof", "and", "and_eq", "asm", "auto", "bitand", "bitor", "bool", "break",
+                "case", "catch", "char", "class", "compl", "const", "constexpr", "const_cast", "continue",
+                "decltype", "default", "delete", "do", "double", "dynamic_cast", "else", "enum", "explicit",
+                "export", "extern", "false", "float", "for", "friend", "goto", "if", "inline", "int", "long",
+                "mutable", "namespace", "new", "noexcept", "not", "not_eq", "nullptr", "operator", "or",
+                "or_eq", "private", "protected", "public", "register", "reinterpret_cast", "return", "short",
+                "signed", "sizeof", "static", "static_assert", "static_cast", "struct", "switch", "template",
+                "this", "thread_local", "throw", "true", "try", "typedef", "typeid", "typename", "union",
+                "unsigned", "using", "virtual", "void", "volatile", "wchar_t", "while", "xor", "xor_eq",
+                "aborted", "aborted_by", "visit"
+            };
+            return words.count(name) != 0;
+        }
+
+        static inline String identifier(const String& id) {
+            String name;
+            for(unsigned char c : id)
+                name += std::isalnum(c) ? static_cast<char>(c) : '_';
+            if(name.empty() || std::isdigit(static_cast<unsigned char>(name[0])))
+                name.insert(0, "_");
+            if(reserved(name))
+                name += '_';
+            return name;
+        }
+
+        inline const CLAB::FlagConfig& flag(size_t flag_idx) const {
+            return _schema.flags_vector[flag_idx];
+        }
+
+        inline const Field& field(size_t flag_idx) const {
+            return _fields[flag(flag_idx).slot];
+        }
+
+        inline void collect() {
+            _fields.resize(_schema.id_names->size());
+            std::set<String> names;
+            for(size_t slot = 0; slot < _fields.size(); ++slot) {
+                Field& f = _fields[slot];
+                f.id = (*_schema.id_names)[static_cast<uint32_t>(slot)];
+                f.name = identifier(f.id);
+                if(names.count(f.name) || names.count(f.name + "_values"))
+                    f.name += "_" + std::to_string(slot);
+                names.insert(f.name);
+                names.insert(f.name + "_values");
+            }
+
+            // Same order as CLAB::initialize_defaults: the last flag of an id sets its state, defaults accumulate.
+            for(size_t flag_idx = 0; flag_idx < _schema.flags_vector.size(); ++flag_idx) {
+                const CLAB::FlagConfig& config = flag(flag_idx);
+                if(config.action)
+                    throw Exception("Cannot generate the action of argument '" + config.id + "'.");
+
+                Field& f = _fields[config.slot];
+                f.state = config.default_toggle;
+                f.defaults.insert(f.defaults.end(), config.default_params.begin(), config.default_params.end());
+                if(config.consumed_args > 0 || !config.default_params.empty() || (config.tags.empty() && config.is_multiple))
+                    f.has_values = true;
+
+                for(const std::pair<const String, CLAB::TagInfo>& tag_info : config.tags)
+                    _tags.emplace(_schema.full_tag(tag_info.first, tag_info.second), Tag{ flag_idx, tag_info.second.toggle_val });
+            }
+        }
+
+        inline void write_result() {
+            _out << "    struct Result {\n";
+            for(const Field& f : _fields) {
+                _out << "        bool " << f.name << " = " << (f.state ? "true" : "false") << "; // " << literal(f.id) << "\n";
+                if(!f.has_values)
+                    continue;
+                _out << "        std::vector<std::string> " << f.name << "_values";
+                if(!f.defaults.empty()) {
+                    _out << "{ ";
+                    for(size_t i = 0; i < f.defaults.size(); ++i)
+                        _out << (i ? ", " : "") << literal(f.defaults[i]);
+                    _out << " }";
+                }
+                _out << ";\n";
+            }
+
+            _out << "        const char* aborted_by = nullptr;\n\n"
+                 << "        bool aborted() const noexcept { return aborted_by != nullptr; }\n\n"
+                 << "        /* Calls `fn(id, state, values)` per id, `values` is null for ids without values. */\n"
+                 << "        template<class Fn>\n"
+                 << "        void visit(Fn&& fn) const {\n";
+            for(const Field& f : _fields)
+                _out << "            fn(" << literal(f.id) << ", " << f.name << ", " << (f.has_values ? "&" + f.name + "_values" : String("static_cast<const std::vector<std::string>*>(nullptr)")) << ");\n";
+            _out << "        }\n"
+                 << "    };\n\n";
+        }
+
+        inline void write_matcher() {
+            std::map<size_t, std::map<unsigned, Vector<std::pair<String, Tag>>>> buckets;
+            for(const std::pair<const String, Tag>& tag : _tags)
+                buckets[tag.first.size()][tag.first.empty() ? 0u : static_cast<unsigned char>(tag.first.back())].push_back(tag);
+
+            _out << "        /* Flag index (declaration order) of a tag, -1 if `t` is not a tag. */\n";
+            if(_tags.empty()) {
+                _out << "        inline int match(std::string_view, bool&) noexcept {\n"
+                     << "            return -1;\n"
+                     << "        }\n\n";
+                return;
+            }
+            _out << "        inline int match(std::string_view t, bool& toggle) noexcept {\n"
+                 << "            switch(t.size()) {\n";
+            for(const auto& by_size : buckets) {
+                _out << "            case " << by_size.first << ":\n";
+                if(by_size.first == 0) {
+                    const std::pair<String, Tag>& tag = by_size.second.begin()->second.front();
+                    _out << "                toggle = " << (tag.second.toggle ? "true" : "false") << ";\n"
+                         << "                return " << tag.second.flag << ";\n";
+                    continue;
+                }
+                _out << "                switch(static_cast<unsigned char>(t.back())) {\n";
+                for(const auto& by_last : by_size.second) {
+                    _out << "                case " << label(by_last.first) << ":\n";
+                    for(const std::pair<String, Tag>& tag : by_last.second) {
+                        _out << "                    if(t == " << literal(tag.first) << ") { toggle = "
+                             << (tag.second.toggle ? "true" : "false") << "; return " << tag.second.flag << "; }\n";
+                    }
+                    _out << "                    break;\n";
+                }
+                _out << "                }\n"
+                     << "                break;\n";
+            }
+            _out << "            }\n"
+                 << "            return -1;\n"
+                 << "        }\n\n";
+        }
+
+        inline void write_allowed() {
+            for(size_t flag_idx = 0; flag_idx < _schema.flags_vector.size(); ++flag_idx) {
+                const CLAB::FlagConfig& config = flag(flag_idx);
+                if(config.allowed_params.empty())
+                    continue;
+
+                std::set<String> allowed(config.allowed_params.begin(), config.allowed_params.end());
+                _out << "        inline bool allowed_" << flag_idx << "(std::string_view v) noexcept {\n"
+                     << "            return ";
+                size_t i = 0;
+                for(const String& value : allowed)
+                    _out << (i++ ? "\n                || " : "") << "v == " << literal(value);
+                _out << ";\n"
+                     << "        }\n\n";
+            }
+        }
+
+        /* Mirrors CLAB::validate_and_store; `check_tag` adds the TokenMismatch test of tagged flags. */
+        inline void write_store(size_t flag_idx, const char* indent, bool check_tag) {
+            const Field& f = field(flag_idx);
+            _out << indent << "std::string_view val = tok[idx];\n";
+            if(check_tag) {
+                _out << indent << "bool d = true;\n"
+                     << indent << "if(detail::match(val, d) >= 0)\n"
+                     << indent << "    throw clab::TokenMismatch(std::string(val));\n";
+            }
+            if(!flag(flag_idx).allowed_params.empty()) {
+                _out << indent << "if(!detail::allowed_" << flag_idx << "(val))\n"
+                     << indent << "    throw clab::InvalidValue(std::string(val));\n";
+            }
+            _out << indent << "r." << f.name << "_values.emplace_back(val);\n"
+                 << indent << "++idx;\n";
+        }
+
+        /* Mirrors CLAB::handle_tagged_token. */
+        inline void write_tagged(size_t flag_idx) {
+            const CLAB::FlagConfig& config = flag(flag_idx);
+            const Field& f = field(flag_idx);
+
+            const bool clears = config.consumed_args > 0 && !config.is_over;
+            _out << "            case " << flag_idx << ": { // " << literal(config.id) << "\n";
+            if(!config.is_multiple || clears)
+                _out << "                bool already_seen = seen[" << config.slot << "] != 0;\n";
+            _out << "                seen[" << config.slot << "] = 1;\n";
+            if(!config.is_multiple) {
+                _out << "                if(already_seen)\n"
+                     << "                    throw clab::RedundantArgument(" << literal(config.id) << ");\n";
+            }
+            if(clears) {
+                _out << "                if(!already_seen)\n"
+                     << "                    r." << f.name << "_values.clear();\n";
+            }
+            _out << "                r." << f.name << " = toggle;\n"
+                 << "                ++idx;\n";
+            if(config.consumed_args > 0) {
+                _out << "                for(std::size_t i = 0; i < " << config.consumed_args << "; ++i) {\n"
+                     << "                    if(idx >= n)\n"
+                     << "                        throw clab::MissingValue(" << literal(config.id) << ");\n";
+                write_store(flag_idx, "                    ", true);
+                _out << "                }\n";
+            }
+            _out << "                continue;\n"
+                 << "            }\n";
+        }
+
+        /* Mirrors CLAB::find_positional and CLAB::handle_positional_token. */
+        inline void write_positionals() {
+            for(size_t flag_idx = 0; flag_idx < _schema.flags_vector.size(); ++flag_idx) {
+                const CLAB::FlagConfig& config = flag(flag_idx);
+                if(!config.tags.empty())
+                    continue;
+
+                const Field& f = field(flag_idx);
+                if(config.is_multiple)
+                    _out << "            { // " << literal(config.id) << "\n";
+                else
+                    _out << "            if(!seen[" << config.slot << "]) { // " << literal(config.id) << "\n";
+
+                const bool clears = (config.is_multiple || config.consumed_args > 0) && !config.is_over;
+                if(clears)
+                    _out << "                bool is_first = !seen[" << config.slot << "];\n";
+                _out << "                seen[" << config.slot << "] = 1;\n";
+                if(clears) {
+                    _out << "                if(is_first)\n"
+                         << "                    r." << f.name << "_values.clear();\n";
+                }
+                _out << "                r." << f.name << " = true;\n";
+                if(config.is_multiple) {
+                    _out << "                while(idx < n) {\n"
+                         << "                    bool d = true;\n"
+                         << "                    if(detail::match(tok[idx], d) >= 0)\n"
+                         << "                        break;\n";
+                    write_store(flag_idx, "                    ", false);
+                    _out << "                }\n";
+                } else if(config.consumed_args > 0) {
+                    _out << "                for(std::size_t i = 0; i < " << config.consumed_args << "; ++i) {\n"
+                         << "                    if(idx >= n)\n"
+                         << "                        throw clab::MissingValue(" << literal(config.id) << ");\n";
+                    write_store(flag_idx, "                    ", false);
+                    _out << "                }\n";
+                }
+                _out << "                continue;\n"
+                     << "            }\n";
+
+                if(config.is_multiple)
+                    return; // always taken, later positionals are unreachable
+            }
+        }
+
+        inline void write_parse() {
+            const size_t slots = _fields.size() + 1;
+
+            _out << "    inline Result parse(const detail::Tokens& tok) {\n"
+                 << "        Result r;\n"
+                 << "        const std::size_t n = tok.size();\n"
+                 << "        unsigned char seen[" << slots << "] = {};\n"
+                 << "        std::size_t idx = 0;\n\n";
+
+            bool any_abort = false;
+            for(const CLAB::FlagConfig& config : _schema.flags_vector)
+                any_abort = any_abort || (config.is_abort && !config.tags.empty());
+            if(any_abort) {
+                _out << "        for(std::size_t i = 0; i < n; ++i) {\n"
+                     << "            bool toggle = false;\n"
+                     << "            switch(detail::match(tok[i], toggle)) {\n";
+                for(size_t flag_idx = 0; flag_idx < _schema.flags_vector.size(); ++flag_idx) {
+                    const CLAB::FlagConfig& config = flag(flag_idx);
+                    if(!config.is_abort || config.tags.empty())
+                        continue;
+                    _out << "            case " << flag_idx << ":\n"
+                         << "                r.aborted_by = " << literal(config.id) << ";\n"
+                         << "                r." << field(flag_idx).name << " = toggle;\n"
+                         << "                return r;\n";
+                }
+                _out << "            default:\n"
+                     << "                break;\n"
+                     << "            }\n"
+                     << "        }\n\n";
+            }
+
+            _out << "        while(idx < n) {\n"
+                 << "            bool toggle = true;\n"
+                 << "            switch(detail::match(tok[idx], toggle)) {\n";
+            for(size_t flag_idx = 0; flag_idx < _schema.flags_vector.size(); ++flag_idx) {
+                if(!flag(flag_idx).tags.empty())
+                    write_tagged(flag_idx);
+            }
+            _out << "            default:\n"
+                 << "                break;\n"
+                 << "            }\n\n";
+            write_positionals();
+            _out << "            throw clab::UnexpectedArgument(std::string(tok[idx]));\n"
+                 << "        }\n\n";
+
+            for(const CLAB::FlagConfig& config : _schema.flags_vector) {
+                if(!config.is_required)
+                    continue;
+                _out << "        if(!seen[" << config.slot << "])\n"
+                     << "            throw clab::MissingArgument(" << literal(config.id) << ");\n";
+            }
+            _out << "        (void)seen; // not read by every schema\n"
+                 << "        return r;\n"
+                 << "    }\n\n"
+                 << "    inline Result parse(const std::vector<std::string>& args) {\n"
+                 << "        return parse(detail::Tokens{ args.data(), nullptr, args.size() });\n"
+                 << "    }\n\n"
+                 << "    /* Like `CLAB::evaluate(argc, argv)`, argv[0] included. */\n"
+                 << "    inline Result parse(int argc, char* const* argv) {\n"
+                 << "        return parse(detail::Tokens{ nullptr, argv, argc > 0 ? static_cast<std::size_t>(argc) : 0 });\n"
+                 << "    }\n\n";
+        }
+
+        ParserGenerator(const CLAB& schema, std::ostream& out, const Options& options)
+            : _schema(schema), _out(out), _options(options) {}
+
+        inline void write() {
+            collect();
+
+            _out << "// Generated by clab::ParserGenerator from a CLAB schema. Do not edit.\n"
+                 << "#pragma once\n\n"
+                 << "#include <cstddef>\n"
+                 << "#include <string>\n"
+                 << "#include <string_view>\n"
+                 << "#include <vector>\n"
+                 << "#include \"" << _options.exceptions_header << "\"\n\n"
+                 << "namespace " << _options.name_space << " {\n\n";
+            write_result();
+
+            _out << "    namespace detail {\n\n"
+                 << "        struct Tokens {\n"
+                 << "            const std::string* strings;\n"
+                 << "            char* const* argv;\n"
+                 << "            std::size_t count;\n\n"
+                 << "            std::string_view operator[](std::size_t i) const noexcept {\n"
+                 << "                return strings ? std::string_view(strings[i]) : std::string_view(argv[i]);\n"
+                 << "            }\n\n"
+                 << "            std::size_t size() const noexcept { return count; }\n"
+                 << "        };\n\n";
+            write_matcher();
+            write_allowed();
+            _out << "    } // namespace detail\n\n";
+
+            write_parse();
+            _out << "} // namespace " << _options.name_space << "\n";
+        }
+
+    public:
+        /*
+        ** @brief Writes a header parsing exactly like `schema.evaluate()` into `out`.
+        ** @note The header declares `Result` (one `bool` per id, plus `<id>_values` for ids with
+        **       values, initialized to the defaults) and `parse(args)` / `parse(argc, argv)`, which
+        **       throw the same exceptions with the same messages. Usage counters, observers and
+        **       occurrence order are not generated.
+        ** @throws Exception if a flag has an action: actions can't be generated.
+        */
+        static inline void write(const CLAB& schema, std::ostream& out, const Options& options) {
+            ParserGenerator(schema, out, options).write();
+        }
+
+        static inline void write(const CLAB& schema, std::ostream& out) {
+            write(schema, out, Options());
+        }
+
+        /** @brief `write` into the file at `path`. Returns false if it can't be written. */
+        static inline bool write_file(const CLAB& schema, const String& path, const Options& options) {
+            std::ofstream file(path);
+            if(!file)
+                return false;
+            write(schema, file, options);
+            return static_cast<bool>(file);
+        }
+
+        static inline bool write_file(const CLAB& schema, const String& path) {
+            return write_file(schema, path, Options());
+        }
+    };
+
+} // namespace clab
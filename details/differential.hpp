@@ -0,0 +1,455 @@
+/*---------------------------------------------------------------*\
+| CLAB - Command Line Arguments Builder                           |
+|                                                                 |
+| File: differential.hpp                                          |
+| Description:                                                    |
+|     Differential testing. Generates random schemas and inputs   |
+|     and checks that every optimized engine (finalized index,    |
+|     reused evaluations, events, embedded mode) agrees with the  |
+|     plain `evaluate`. Usable as a quick check or a libFuzzer    |
+|     target, and to check generated parsers case by case.        |
+|     Opt-in: include this header explicitly.                     |
+|                                                                 |
+| Minimum Standard: ISO C++17                                     |
+| License: MIT (c) 2025                                           |
+\*---------------------------------------------------------------*/
+
+#pragma once
+
+#include <algorithm>
+#include <sstream>
+#include "../clab.hpp"
+#include "fixed.hpp"
+
+namespace clab {
+
+    /*------------------------------*\
+    | Differential:                  |
+    | Reference `evaluate` against   |
+    | the optimized engines on       |
+    | generated cases.               |
+    \*------------------------------*/
+    class Differential {
+    public:
+        struct Options {
+            size_t max_flags = 6;
+            size_t max_tokens = 8;
+            size_t inputs_per_schema = 16;
+        };
+
+    private:
+        using Fixed = FixedCLAB<16, 48, 96, 4096>;
+
+        struct TagSpec {
+            String tag;
+            String prefix;
+            int toggle; // -1: `flag()`, 0/1: `toggle(value)`
+        };
+
+        struct FlagSpec {
+            String id;
+            Vector<TagSpec> tags;
+            size_t consume = 0;
+            bool allowed = false;
+            bool required = false;
+            bool multiple = false;
+            bool over = false;
+            bool abort = false;
+            bool initial_state = false;
+            bool initial_value = false;
+        };
+
+        /* Draws from the fuzzer input, then zeros once it runs out, so every input is a valid case. */
+        class ByteSource {
+            const uint8_t* _data;
+            size_t _size;
+            size_t _pos = 0;
+
+        public:
+            ByteSource(const uint8_t* data, size_t size) noexcept : _data(data), _size(size) {}
+
+            inline size_t pick(size_t n) noexcept {
+                uint8_t b = _pos < _size ? _data[_pos++] : 0;
+                return n ? b % n : 0;
+            }
+
+            inline bool chance(size_t one_in) noexcept {
+                return pick(one_in) == 0;
+            }
+        };
+
+        // small alphabets so tags and values collide often; ids and tags repeat only on purpose
+        static constexpr const char* id_alphabet[] = { "p", "q", "r", "s", "t", "u" };
+        static constexpr const char* tag_alphabet[] = { "x", "y", "all", "-x" };
+        static constexpr const char* token_alphabet[] = { "a", "b", "v1", "d", "-x", "--x", "-y", "y", "--all", "-" };
+
+        /*
+        ** Most schemas have distinct ids and full tags and no positional mixing `consume` with
+        ** `multiple()`, so they finalize and every engine is compared. One in `clash_one_in` draws
+        ** freely, to cover building errors and the schemas `finalize()` rejects.
+        */
+        static constexpr size_t clash_one_in = 8;
+
+        Options _options;
+
+        inline Vector<FlagSpec> make_schema(ByteSource& src) const {
+            Vector<FlagSpec> schema(1 + src.pick(_options.max_flags));
+            bool clash = src.chance(clash_one_in);
+            Vector<String> full_tags;
+            for(size_t i = 0; i < schema.size(); ++i) {
+                FlagSpec& f = schema[i];
+                constexpr size_t ids = sizeof(id_alphabet) / sizeof(id_alphabet[0]);
+                f.id = id_alphabet[clash ? src.pick(ids) : i % ids];
+                size_t tag_count = src.pick(3);
+                for(size_t t = 0; t < tag_count; ++t) {
+                    int toggle = src.chance(4) ? static_cast<int>(src.pick(2)) : -1;
+                    TagSpec tag = { tag_alphabet[src.pick(4)], src.pick(2) ? "-" : "--", toggle };
+                    String full = tag.prefix + tag.tag;
+                    bool taken = std::find(full_tags.begin(), full_tags.end(), full) != full_tags.end()
+                        || std::any_of(f.tags.begin(), f.tags.end(), [&](const TagSpec& o) { return o.tag == tag.tag; });
+                    if(taken && !clash)
+                        continue;
+                    full_tags.push_back(full);
+                    f.tags.push_back(tag);
+                }
+                f.consume = src.pick(3);
+                f.multiple = src.chance(3);
+                f.over = src.chance(6); // implies `multiple()`
+                if(f.tags.empty() && (f.multiple || f.over) && !clash)
+                    f.consume = 0;
+                f.allowed = src.chance(3);
+                f.required = src.chance(3);
+                f.abort = src.chance(6);
+                f.initial_state = src.chance(3);
+                f.initial_value = src.chance(3);
+            }
+            return schema;
+        }
+
+        inline Vector<String> make_args(ByteSource& src) const {
+            Vector<String> args(src.pick(_options.max_tokens + 1));
+            for(String& a : args)
+                a = token_alphabet[src.pick(sizeof(token_alphabet) / sizeof(token_alphabet[0]))];
+            return args;
+        }
+
+        /* Fills `buffer` with the bytes of case `c` of `check(cases, seed)` (splitmix64). */
+        static inline void case_bytes(size_t c, uint64_t seed, uint8_t (&buffer)[256]) noexcept {
+            seed += static_cast<uint64_t>(c) * sizeof(buffer) * 0x9e3779b97f4a7c15ull;
+            for(uint8_t& b : buffer) {
+                seed += 0x9e3779b97f4a7c15ull;
+                uint64_t z = seed;
+                z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+                z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+                b = static_cast<uint8_t>(z ^ (z >> 31));
+            }
+        }
+
+        /* Declares `schema` with the fluent API shared by `CLAB` and `FixedCLAB`. */
+        template<class Builder>
+        static inline void declare(Builder& builder, const FlagSpec& f) {
+            auto flag = builder.start(f.id);
+            for(const TagSpec& t : f.tags) {
+                if(t.toggle < 0)
+                    flag.flag(t.tag, t.prefix);
+                else
+                    flag.toggle(t.toggle != 0, t.tag, t.prefix);
+            }
+            if(f.allowed)
+                flag.consume(f.consume, { "a", "v1" });
+            else
+                flag.consume(f.consume);
+            if(f.required) flag.required();
+            if(f.multiple) flag.multiple();
+            if(f.over) flag.over();
+            if(f.abort) flag.abort();
+            if(f.initial_state) flag.initial(true);
+            if(f.initial_value) flag.initial({ "d" });
+            flag.end();
+        }
+
+        static inline String describe(const Vector<FlagSpec>& schema, const Vector<String>& args) {
+            std::ostringstream os;
+            for(const FlagSpec& f : schema) {
+                os << "start(\"" << f.id << "\")";
+                for(const TagSpec& t : f.tags) {
+                    if(t.toggle < 0)
+                        os << ".flag(\"" << t.tag << "\", \"" << t.prefix << "\")";
+                    else
+                        os << ".toggle(" << (t.toggle ? "true" : "false") << ", \"" << t.tag << "\", \"" << t.prefix << "\")";
+                }
+                os << ".consume(" << f.consume << (f.allowed ? ", {a, v1})" : ")");
+                if(f.required) os << ".required()";
+                if(f.multiple) os << ".multiple()";
+                if(f.over) os << ".over()";
+                if(f.abort) os << ".abort()";
+                if(f.initial_state) os << ".initial(true)";
+                if(f.initial_value) os << ".initial({d})";
+                os << ".end();\n";
+            }
+            os << "args:";
+            for(const String& a : args)
+                os << " '" << a << '\'';
+            return os.str();
+        }
+
+        static inline Vector<String> distinct_ids(const Vector<FlagSpec>& schema) {
+            Vector<String> out;
+            for(const FlagSpec& f : schema) {
+                if(std::find(out.begin(), out.end(), f.id) == out.end())
+                    out.push_back(f.id);
+            }
+            return out;
+        }
+
+        /* Full tags (`prefix + tag`) declared more than once: the reference matches them in hash order. */
+        static inline Vector<String> ambiguous_tags(const Vector<FlagSpec>& schema) {
+            Vector<String> seen, out;
+            for(const FlagSpec& f : schema) {
+                for(const TagSpec& t : f.tags) {
+                    String full = t.prefix + t.tag;
+                    if(std::find(seen.begin(), seen.end(), full) == seen.end())
+                        seen.push_back(full);
+                    else if(std::find(out.begin(), out.end(), full) == out.end())
+                        out.push_back(full);
+                }
+            }
+            return out;
+        }
+
+        /* Runs `fn` and renders the exception it throws, empty if none. */
+        template<class Fn>
+        static inline String error_of(Fn&& fn) {
+            try {
+                fn();
+            } catch(const MissingArgument& e) {
+                return String("MissingArgument ") + e.what();
+            } catch(const InvalidValue& e) {
+                return String("InvalidValue ") + e.what();
+            } catch(const UnexpectedArgument& e) {
+                return String("UnexpectedArgument ") + e.what();
+            } catch(const RedundantArgument& e) {
+                return String("RedundantArgument ") + e.what();
+            } catch(const TokenMismatch& e) {
+                return String("TokenMismatch ") + e.what();
+            } catch(const MissingValue& e) {
+                return String("MissingValue ") + e.what();
+            } catch(const InvalidBuilding& e) {
+                return String("InvalidBuilding ") + e.what();
+            }
+            return {};
+        }
+
+        template<class Eval>
+        static inline String render(const Eval& eval, const Vector<String>& ids) {
+            std::ostringstream os;
+            if(eval.aborted())
+                os << "aborted by " << eval.aborted_id() << "; ";
+            for(const String& id : ids) {
+                os << id << '=' << eval.state(id) << " [";
+                for(const auto& v : eval.values(id))
+                    os << v << ',';
+                os << "] ";
+            }
+            return os.str();
+        }
+
+        /* Occurrences of the reference as `flag:value` (value empty for occurrences without one). */
+        static inline String render_order(const CLAB& parser, const Evaluation& eval) {
+            std::ostringstream os;
+            for(const Evaluation::Occurrence& o : eval.occurrences()) {
+                os << o.flag << ':';
+                if(o.offset != Evaluation::Occurrence::no_value)
+                    os << eval.values(parser.id_of(o.flag))[o.offset];
+                os << ' ';
+            }
+            return os.str();
+        }
+
+        static inline String mismatch(const char* engine, const Vector<FlagSpec>& schema, const Vector<String>& args,
+            const String& expected, const String& actual) {
+            return String(engine) + " differs from evaluate\n" + describe(schema, args)
+                + "\nexpected: " + expected + "\nactual:   " + actual;
+        }
+
+    public:
+        Differential() = default;
+        explicit Differential(Options options) : _options(options) {}
+
+        /*
+        ** @brief Builds one schema and `inputs_per_schema` inputs from `data` and compares every engine.
+        ** @note Schemas `finalize()` rejects skip only the finalized `evaluate`; the other engines
+        **       run on the builder as declared, and `FixedCLAB` only on inputs without a tag declared
+        **       twice (the reference resolves those in hash order). Schemas that don't build compare
+        **       the building errors.
+        ** @return Empty if every engine agrees, else the schema, input and both results.
+        */
+        inline String run(const uint8_t* data, size_t size) const {
+            ByteSource src(data, size);
+            Vector<FlagSpec> schema = make_schema(src);
+            Vector<String> ids = distinct_ids(schema);
+
+            CLAB reference;
+            Fixed fixed;
+            reference.record_order();
+            for(const FlagSpec& f : schema) {
+                String built = error_of([&] { declare(reference, f); });
+                declare(fixed, f);
+                bool fixed_failed = fixed.status().code == ErrorCode::InvalidBuilding;
+                if(!built.empty() || fixed_failed) {
+                    if(built.empty() != !fixed_failed)
+                        return mismatch("FixedCLAB (building)", schema, {}, built, error_name(fixed.status().code));
+                    return {};
+                }
+            }
+
+            // schemas `finalize()` rejects still run through every engine but the index
+            CLAB finalized = reference;
+            bool indexed = error_of([&] { finalized.finalize(); }).empty();
+            const CLAB& engine = indexed ? finalized : reference;
+            Vector<String> ambiguous = indexed ? Vector<String>() : ambiguous_tags(schema);
+
+            Evaluation reused;
+            Fixed::Evaluation fixed_eval;
+            for(size_t input = 0; input < _options.inputs_per_schema; ++input) {
+                Vector<String> args = make_args(src);
+
+                String expected, order;
+                String error = error_of([&] {
+                    Evaluation eval = reference.evaluate(args);
+                    expected = render(eval, ids);
+                    order = render_order(reference, eval);
+                });
+                if(!error.empty())
+                    expected = error;
+
+                String actual;
+                if(indexed) {
+                    error = error_of([&] { actual = render(finalized.evaluate(args), ids); });
+                    if((error.empty() ? actual : error) != expected)
+                        return mismatch("finalized evaluate", schema, args, expected, error.empty() ? actual : error);
+                }
+
+                error = error_of([&] { engine.evaluate(args, reused); actual = render(reused, ids); });
+                if((error.empty() ? actual : error) != expected)
+                    return mismatch("evaluate(args, out)", schema, args, expected, error.empty() ? actual : error);
+
+                // the reference and `FixedCLAB` may pick different owners for an ambiguous tag
+                bool hits_ambiguous = std::any_of(args.begin(), args.end(), [&](const String& a) {
+                    return std::find(ambiguous.begin(), ambiguous.end(), a) != ambiguous.end();
+                });
+                Status status = fixed.evaluate(args, fixed_eval);
+                actual = status.ok() ? render(fixed_eval, ids) : error_name(status.code) + String(" ") + String(status.subject);
+                if(!hits_ambiguous && actual != expected)
+                    return mismatch("FixedCLAB", schema, args, expected, actual);
+
+                // events apply no defaults: compare the occurrence order and the errors instead
+                std::ostringstream events;
+                error = error_of([&] {
+                    for(const Event& ev : engine.events(args))
+                        events << ev.flag << ':' << ev.value << ' ';
+                });
+                if(!error.empty() ? error != expected : events.str() != order)
+                    return mismatch("events", schema, args, order.empty() ? expected : order, error.empty() ? events.str() : error);
+            }
+            return {};
+        }
+
+        /*
+        ** @brief Runs `cases` generated cases from `seed`, for a quick check in a test suite.
+        ** @return Empty if every engine agrees, else the first mismatch (see `run`).
+        */
+        inline String check(size_t cases, uint64_t seed = 1) const {
+            uint8_t buffer[256];
+            for(size_t c = 0; c < cases; ++c) {
+                case_bytes(c, seed, buffer);
+                String result = run(buffer, sizeof(buffer));
+                if(!result.empty())
+                    return result;
+            }
+            return {};
+        }
+
+        /*
+        ** @brief Declares the schema of case `c` of `check(cases, seed)` into `out`, a fresh builder,
+        **        e.g. to write it out with `ParserGenerator`.
+        ** @return false if the case is skipped: the schema doesn't build or `finalize()` rejects it.
+        */
+        inline bool schema(size_t c, uint64_t seed, CLAB& out) const {
+            uint8_t buffer[256];
+            case_bytes(c, seed, buffer);
+            ByteSource src(buffer, sizeof(buffer));
+            for(const FlagSpec& f : make_schema(src)) {
+                if(!error_of([&] { declare(out, f); }).empty())
+                    return false;
+            }
+            CLAB finalized = out;
+            return error_of([&] { finalized.finalize(); }).empty();
+        }
+
+        /*
+        ** @brief Compares a parser generated from `schema(c, seed)` with `evaluate` on the inputs of that case.
+        ** @param parse Calls the generated `parse(args)` for a `const Vector<String>&` and returns its `Result`.
+        ** @return Empty if they agree (or the case is skipped), else the schema, input and both results.
+        */
+        template<class Parse>
+        inline String check_generated(size_t c, uint64_t seed, Parse&& parse) const {
+            CLAB reference;
+            if(!schema(c, seed, reference))
+                return {};
+
+            uint8_t buffer[256];
+            case_bytes(c, seed, buffer);
+            ByteSource src(buffer, sizeof(buffer));
+            Vector<FlagSpec> specs = make_schema(src);
+            Vector<String> ids = distinct_ids(specs);
+
+            for(size_t input = 0; input < _options.inputs_per_schema; ++input) {
+                Vector<String> args = make_args(src);
+
+                String expected;
+                String error = error_of([&] { expected = render(reference.evaluate(args), ids); });
+                if(!error.empty())
+                    expected = error;
+
+                String actual;
+                error = error_of([&] {
+                    auto result = parse(args);
+                    std::ostringstream os;
+                    if(result.aborted())
+                        os << "aborted by " << result.aborted_by << "; ";
+                    result.visit([&](const char* id, bool state, const std::vector<std::string>* values) {
+                        os << id << '=' << state << " [";
+                        for(size_t v = 0; values && v < values->size(); ++v)
+                            os << (*values)[v] << ',';
+                        os << "] ";
+                    });
+                    actual = os.str();
+                });
+                if((error.empty() ? actual : error) != expected)
+                    return mismatch("generated parser", specs, args, expected, error.empty() ? actual : error);
+            }
+            return {};
+        }
+    };
+
+} // namespace clab
+
+/*
+** libFuzzer entry point: build one TU with CLAB_DIFFERENTIAL_FUZZER defined and -fsanitize=fuzzer.
+** A mismatch is printed and aborts, which the fuzzer reports as a crash.
+*/
+#if defined(CLAB_DIFFERENTIAL_FUZZER)
+#include <cstdio>
+#include <cstdlib>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    static const clab::Differential differential;
+    clab::String result = differential.run(data, size);
+    if(!result.empty()) {
+        std::fprintf(stderr, "%s\n", result.c_str());
+        std::abort();
+    }
+    return 0;
+}
+#endif
@@ -4,7 +4,8 @@
 | File: evaluation.hpp                                            |
 | Description:                                                    |
 |     Result container for the parsing process. Stores states      |
-|     and parameters for each flag/positional.                    |
+|     and parameters for each flag/positional, in slots indexed   |
+|     by the interned flag ids of the schema.                     |
 |                                                                 |
 | Minimum Standard: ISO C++17                                     |
 | License: MIT (c) 2025                                           |
@@ -12,40 +13,361 @@
 
 #pragma once
 
-#include <unordered_map>
 #include <string>
+#include <string_view>
+#include <iterator>
+#include <cassert>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
 #include "types.hpp"
+#include "events.hpp"
+#include "intern.hpp"
 #include <optional>
 
 namespace clab {
+
+    /*------------------------------*\
+    | ValueList:                     |
+    | View over the values of a flag,|
+    | each packed with the input     |
+    | index it was read from. Reads  |
+    | like a Vector<String>.         |
+    \*------------------------------*/
+    class ValueList {
+        friend class Evaluation;
+
+    public:
+        static constexpr uint32_t no_token = UINT32_MAX; // defaults were not read from the input
+
+        struct Located {
+            std::string_view value;
+            size_t token;
+        };
+
+        struct Entry {
+            uint32_t value; // id in the evaluation's value pool
+            uint32_t token;
+        };
+
+    private:
+        static constexpr uint64_t fnv_basis = 14695981039346656037ull;
+        static constexpr uint64_t fnv_prime = 1099511628211ull;
+
+        static inline uint64_t fold(uint64_t fingerprint, std::string_view v) noexcept {
+            for(unsigned char c : v)
+                fingerprint = (fingerprint ^ c) * fnv_prime;
+            return (fingerprint ^ 0xFFu) * fnv_prime; // value separator
+        }
+
+        const Entry* _data = nullptr;
+        size_t _size = 0;
+        size_t _capacity = 0;
+        const StringPool* _pool = nullptr;
+        uint64_t _fingerprint = fnv_basis;
+
+        ValueList(const Vector<Entry>& entries, const StringPool& pool, uint64_t fingerprint) noexcept
+            : _data(entries.data()), _size(entries.size()), _capacity(entries.capacity()), _pool(&pool), _fingerprint(fingerprint) {}
+
+    public:
+        class const_iterator {
+            const Entry* _it = nullptr;
+            const StringPool* _pool = nullptr;
+
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = String;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const String*;
+            using reference = const String&;
+
+            const_iterator() = default;
+            const_iterator(const Entry* it, const StringPool* pool) : _it(it), _pool(pool) {}
+
+            inline reference operator*() const { return (*_pool)[_it->value]; }
+            inline pointer operator->() const { return &(*_pool)[_it->value]; }
+            inline reference operator[](difference_type n) const { return (*_pool)[_it[n].value]; }
+
+            inline const_iterator& operator++() { ++_it; return *this; }
+            inline const_iterator operator++(int) { return const_iterator(_it++, _pool); }
+            inline const_iterator& operator--() { --_it; return *this; }
+            inline const_iterator operator--(int) { return const_iterator(_it--, _pool); }
+            inline const_iterator& operator+=(difference_type n) { _it += n; return *this; }
+            inline const_iterator& operator-=(difference_type n) { _it -= n; return *this; }
+            inline const_iterator operator+(difference_type n) const { return const_iterator(_it + n, _pool); }
+            inline const_iterator operator-(difference_type n) const { return const_iterator(_it - n, _pool); }
+            inline difference_type operator-(const const_iterator& o) const { return _it - o._it; }
+
+            inline bool operator==(const const_iterator& o) const { return _it == o._it; }
+            inline bool operator!=(const const_iterator& o) const { return _it != o._it; }
+            inline bool operator<(const const_iterator& o) const { return _it < o._it; }
+            inline bool operator>(const const_iterator& o) const { return _it > o._it; }
+            inline bool operator<=(const const_iterator& o) const { return _it <= o._it; }
+            inline bool operator>=(const const_iterator& o) const { return _it >= o._it; }
+        };
+
+        using iterator = const_iterator;
+
+        ValueList() = default;
+
+        /** @brief Order-sensitive hash of the values (not their positions), kept up to date on insert. */
+        inline uint64_t fingerprint() const noexcept { return _fingerprint; }
+
+        inline size_t size() const noexcept { return _size; }
+        inline size_t capacity() const noexcept { return _capacity; }
+        inline bool empty() const noexcept { return _size == 0; }
+
+        inline const String& operator[](size_t i) const { return (*_pool)[_data[i].value]; }
+        inline const String& at(size_t i) const { return (*_pool)[entry(i).value]; }
+        inline const String& front() const { return (*_pool)[_data[0].value]; }
+        inline const String& back() const { return (*_pool)[_data[_size - 1].value]; }
+
+        /** @brief Input index the value at `i` was read from, or `no_token` for defaults. */
+        inline size_t token(size_t i) const { return entry(i).token; }
+
+        /** @brief Returns `(value, input index)` for the value at `i`. */
+        inline Located located(size_t i) const {
+            const Entry& e = entry(i);
+            return { (*_pool)[e.value], e.token };
+        }
+
+        inline const_iterator begin() const noexcept { return const_iterator(_data, _pool); }
+        inline const_iterator end() const noexcept { return const_iterator(_data + _size, _pool); }
+
+        /** @brief Copies the values out, dropping their positions. */
+        inline operator Vector<String>() const {
+            return Vector<String>(begin(), end());
+        }
+
+    private:
+        inline const Entry& entry(size_t i) const {
+            if(i >= _size)
+                throw std::out_of_range("ValueList: index " + std::to_string(i) + " out of range.");
+            return _data[i];
+        }
+    };
+
+    struct FlagIdBase {};
+
+    /*------------------------------*\
+    | FlagId:                        |
+    | Compile-time handle of a flag  |
+    | id in schema `S`, and what     |
+    | `get` returns (bool = state,   |
+    | String = last value,           |
+    | ValueList).                    |
+    \*------------------------------*/
+    template<class S, class T = bool>
+    struct FlagId : FlagIdBase {
+        using schema = S;
+        using type = T;
+    };
+
+    /*------------------------------*\
+    | Schema:                        |
+    | Ordered list of the typed ids  |
+    | of a builder. The slot of each |
+    | id is its position here.       |
+    \*------------------------------*/
+    template<class... Ids>
+    struct Schema {
+        static constexpr size_t size = sizeof...(Ids);
+
+        template<class F>
+        static constexpr bool contains = (std::is_same_v<F, Ids> || ...);
+
+        template<class F>
+        static constexpr size_t slot_of() noexcept {
+            static_assert(contains<F>, "FlagId type is not listed in its schema");
+            size_t slot = 0;
+            bool found = false;
+            ((found = found || std::is_same_v<F, Ids>, slot += found ? 0 : 1), ...);
+            return slot;
+        }
+    };
+
+    /* Slot of the typed id `F`: its position in `F::schema`. */
+    template<class F>
+    inline constexpr size_t flag_slot = F::schema::template slot_of<F>();
+
     class Evaluation {
     public:
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
         struct Flag {
             Vector<String> list{};
             bool state{};
         };
+
+        struct Occurrence {
+            static constexpr uint32_t no_value = UINT32_MAX;
+
+            uint32_t flag;   // index of the flag, in declaration order
+            uint32_t offset; // index of the value in `values(id)`, or `no_value`
+        };
+
+        struct Change {
+            String id;
+            bool state = false;  // the boolean state differs
+            bool values = false; // the value list differs
+        };
     private:
-        std::unordered_map<String, Flag> _flags_info;
+        struct Slot {
+            Vector<ValueList::Entry> values;
+            uint64_t fingerprint = ValueList::fnv_basis;
+            bool state = false;
+        };
+
+        Shared<const StringPool> _ids;   // schema ids: slot `i` belongs to `(*_ids)[i]`, kept alive past the builder
+        StringPool _extra_ids;           // ids the schema doesn't know, in the slots after `_ids`
+        Vector<Slot> _slots;
+        StringPool _values;
         std::optional<String> _abort_id = std::nullopt;
+        Vector<Occurrence> _occurrences;
+        SeenSet _provided;               // scratch of `CLAB::evaluate`, kept so reuse doesn't reallocate it
+
+        inline size_t schema_size() const noexcept {
+            return _ids ? _ids->size() : 0;
+        }
+
+        inline const String& id_at(size_t slot) const {
+            size_t known = schema_size();
+            return slot < known ? (*_ids)[static_cast<uint32_t>(slot)] : _extra_ids[static_cast<uint32_t>(slot - known)];
+        }
+
+        inline size_t slot_for(const String& id) {
+            size_t slot = slot_of(id);
+            if(slot != npos)
+                return slot;
+
+            slot = schema_size() + _extra_ids.intern(id);
+            if(slot >= _slots.size())
+                _slots.resize(slot + 1);
+            return slot;
+        }
+
+        inline ValueList view(const Slot& s) const noexcept {
+            return ValueList(s.values, _values, s.fingerprint);
+        }
 
     public:
         Evaluation() = default;
         ~Evaluation() = default;
 
+        /*
+        ** @brief Starts an evaluation whose slots follow the interned ids of a schema (what `CLAB::evaluate` uses).
+        ** @param intern_values Store repeated values once; lists then hold ids of the shared copy.
+        ** @note Sharing `ids` costs one atomic increment here and one decrement on destruction. An
+        **       evaluation is returned by value and may outlive its builder (or the builder's next
+        **       `start()` may replace the pool), so a plain pointer could dangle. `reset` keeps the
+        **       pool it already holds, so `CLAB::evaluate(args, out)` pays neither.
+        */
+        explicit Evaluation(Shared<const StringPool> ids, bool intern_values = false)
+            : _ids(std::move(ids)), _slots(schema_size()), _values(intern_values) {}
+
+        /*
+        ** @brief Empties the evaluation for a new parse against the schema `ids`, keeping its buffers.
+        ** @note Used by `CLAB::evaluate(args, out)`: once the buffers are large enough, parsing into
+        **       the same evaluation again allocates nothing.
+        ** @note `Pool` is `StringPool` or `const StringPool`: the builder's own pointer is compared
+        **       as is, without a converted temporary and its reference count traffic.
+        */
+        template<class Pool>
+        inline void reset(const Shared<Pool>& ids, bool intern_values = false) {
+            if(_ids != ids)
+                _ids = ids;
+            _extra_ids.clear();
+            _slots.resize(schema_size());
+            for(Slot& s : _slots) {
+                s.values.clear();
+                s.fingerprint = ValueList::fnv_basis;
+                s.state = false;
+            }
+
+            if(_values.indexed() == intern_values)
+                _values.clear();
+            else
+                _values = StringPool(intern_values);
+            _abort_id.reset();
+            _occurrences.clear();
+        }
+
+        /*
+        ** @brief Cleared set of `slots` bits, for `CLAB::evaluate` to mark the ids given in the input.
+        ** @note Owned by the evaluation so large schemas (over `SeenSet::inline_bits` ids) don't
+        **       allocate it again on every `evaluate(args, out)`.
+        */
+        inline SeenSet& provided_scratch(size_t slots) {
+            _provided.reset(slots);
+            return _provided;
+        }
+
+        /** @brief Slot of an ID (its `FlagConfig::slot` for schema ids), or `npos` if it was never set. */
+        inline size_t slot_of(const String& id) const noexcept {
+            if(_ids) {
+                uint32_t k = _ids->find(id);
+                if(k != StringPool::npos)
+                    return k;
+            }
+
+            uint32_t k = _extra_ids.find(id);
+            return k == StringPool::npos ? npos : schema_size() + k;
+        }
 
         /** @brief Sets the found state (boolean) for a given flag ID. */
         inline void set_state(const String& id, bool v) {
-            _flags_info[id].state = v;
+            set_state_at(slot_for(id), v);
+        }
+
+        /** @brief `set_state` by slot, no lookup. */
+        inline void set_state_at(size_t slot, bool v) noexcept {
+            _slots[slot].state = v;
         }
 
-        /** @brief Adds a string value to the parameter list of a flag ID. */
-        inline void add_param(const String& id, const String& v) {
-            _flags_info[id].list.push_back(v);
+        /*
+        ** @brief Adds a string value to the parameter list of a flag ID. Returns its index in the list.
+        ** @param token Input index the value was read from, `ValueList::no_token` for defaults.
+        */
+        inline size_t add_param(const String& id, std::string_view v, size_t token = ValueList::no_token) {
+            return add_param_at(slot_for(id), v, token);
+        }
+
+        /** @brief `add_param` by slot, no lookup. */
+        inline size_t add_param_at(size_t slot, std::string_view v, size_t token = ValueList::no_token) {
+            Slot& s = _slots[slot];
+            s.values.push_back({ _values.intern(v), static_cast<uint32_t>(token) });
+            s.fingerprint = ValueList::fold(s.fingerprint, v);
+            return s.values.size() - 1;
+        }
+
+        /** @brief Appends an entry to the occurrence log. */
+        inline void log_occurrence(size_t flag, size_t offset) {
+            _occurrences.push_back({ static_cast<uint32_t>(flag), static_cast<uint32_t>(offset) });
+        }
+
+        inline void reserve_occurrences(size_t n) {
+            _occurrences.reserve(n);
+        }
+
+        /** @brief Reserves room for `n` values (in the value pool, not per list). */
+        inline void reserve_values(size_t n) {
+            _values.reserve(n);
+        }
+
+        /** @brief Every distinct stored value (every stored value unless values are interned). */
+        inline const StringPool& value_pool() const noexcept {
+            return _values;
         }
 
         /** @brief Removes all stored values for a specific flag ID. */
         inline void clear_params(const String& id) {
-            _flags_info[id].list.clear();
+            clear_params_at(slot_for(id));
+        }
+
+        /** @brief `clear_params` by slot, no lookup. Cleared values stay in the pool until the evaluation dies. */
+        inline void clear_params_at(size_t slot) noexcept {
+            _slots[slot].values.clear();
+            _slots[slot].fingerprint = ValueList::fnv_basis;
         }
 
         /** @brief Sets the ID of the flag that triggered a parsing abort. */
@@ -55,42 +377,89 @@ namespace clab {
 
         /** @brief Returns the boolean state of a flag. Returns false if not found. */
         inline bool state(const String& id) const {
-            auto it = _flags_info.find(id);
-            if(it == _flags_info.end())
-                return false;
-
-            return it->second.state;
+            size_t slot = slot_of(id);
+            return slot != npos && _slots[slot].state;
         }
 
-        /** @brief Returns all values associated with an ID. Returns an empty vector if none. */
-        inline const Vector<String>& list(const String& id) const {
-            static const Vector<String> empty;
+        /*
+        ** @brief Returns a copy of all values associated with an ID. Returns an empty list if none.
+        ** @note Use `values(id)` to read them without copying.
+        */
+        inline Vector<String> list(const String& id) const {
+            return values(id);
+        }
 
-            auto it = _flags_info.find(id);
-            if(it == _flags_info.end())
-                return empty;
+        /** @brief Returns all values associated with an ID as a view, valid as long as the evaluation. */
+        inline ValueList values(const String& id) const {
+            size_t slot = slot_of(id);
+            return slot == npos ? ValueList() : list_at(slot);
+        }
 
-            return it->second.list;
+        /** @brief `values` by slot, no lookup. */
+        inline ValueList list_at(size_t slot) const noexcept {
+            return view(_slots[slot]);
         }
 
         inline Shared<Flag> handle(const String& id) const {
-            auto it = _flags_info.find(id);
-            if(it == _flags_info.end())
+            size_t slot = slot_of(id);
+            if(slot == npos)
                 return nullptr;
-            return std::make_shared<Flag>(it->second);
+            return std::make_shared<Flag>(Flag{ list_at(slot), _slots[slot].state });
+        }
+
+        /*
+        ** @brief Typed access by `FlagId`, an array access with no lookup.
+        ** @note `F` must be listed in its `Schema`, or this doesn't compile. An evaluation of a builder
+        **       that didn't declare `F` has no slot for it: `get` then returns false, an empty string or
+        **       an empty list. Debug builds (no `NDEBUG`) also assert that the slot holds `F::id`.
+        */
+        template<class F>
+        inline decltype(auto) get() const {
+            static_assert(std::is_base_of_v<FlagIdBase, F>, "get<F>() needs a clab::FlagId type");
+            static_assert(F::schema::template contains<F>, "get<F>(): F is not listed in its schema");
+            using T = typename F::type;
+            constexpr size_t slot = flag_slot<F>;
+            const Slot* s = slot < _slots.size() ? &_slots[slot] : nullptr;
+            assert((!s || id_at(slot) == F::id) && "get<F>(): the slot of F holds another id");
+
+            if constexpr(std::is_same_v<T, bool>) {
+                return s ? s->state : false;
+            } else if constexpr(std::is_same_v<T, String>) {
+                static const String empty;
+                return !s || s->values.empty() ? empty : _values[s->values.back().value];
+            } else {
+                static_assert(std::is_same_v<T, ValueList>, "FlagId type must be bool, String or ValueList");
+                return s ? view(*s) : ValueList();
+            }
+        }
+
+        /** @brief Returns the `i`-th value of an ID with the input index it was read from. */
+        inline ValueList::Located located(const String& id, size_t i) const {
+            return values(id).located(i);
         }
 
         /** @brief Returns the last value added to a flag. Returns empty string if none. */
         inline const String& value(const String& id) const {
             static const String empty;
 
-            auto it = _flags_info.find(id);
-            if(it->second.list.empty() || it == _flags_info.end())
+            ValueList all = values(id);
+            if(all.empty())
                 return empty;
 
-            return it->second.list.back();
+            return all.back();
         }
 
+        /** @brief Every flag occurrence in input order. Empty unless `CLAB::record_order()` is enabled. */
+        inline const Vector<Occurrence>& occurrences() const {
+            return _occurrences;
+        }
+
+        /*
+        ** @brief Lists the IDs whose state or values differ in `other`, sorted by ID.
+        ** @note Values are compared by size and fingerprint, not string by string.
+        */
+        Vector<Change> diff(const Evaluation& other) const; // details/clab_impl.hpp
+
         /** @brief Checks if the parsing was aborted by a specific flag. */
         inline bool aborted() const {
             return _abort_id.has_value();
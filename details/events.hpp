@@ -0,0 +1,109 @@
+/*---------------------------------------------------------------*\
+| CLAB - Command Line Arguments Builder                           |
+|                                                                 |
+| File: events.hpp                                                |
+| Description:                                                    |
+|     Building blocks of the pull parser: the event record, a     |
+|     non-owning view over the input tokens and the bitset used   |
+|     to remember which ids were already provided.                |
+|                                                                 |
+| Minimum Standard: ISO C++17                                     |
+| License: MIT (c) 2025                                           |
+\*---------------------------------------------------------------*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include "types.hpp"
+
+namespace clab {
+
+    /*------------------------------*\
+    | Event:                         |
+    | One occurrence of a flag or    |
+    | one value stored for it.       |
+    \*------------------------------*/
+    struct Event {
+        size_t flag = 0;             // index of the flag, in declaration order
+        bool toggle = true;          // state the occurrence sets
+        std::string_view value{};    // empty when the flag consumes nothing
+        size_t token = 0;            // index of `value` (or of the tag) in the input
+    };
+
+    /*------------------------------*\
+    | TokenView:                     |
+    | Non-owning view over either a  |
+    | Vector<String> or argv.        |
+    \*------------------------------*/
+    class TokenView {
+        const String* _strings = nullptr;
+        char* const* _argv = nullptr;
+        size_t _size = 0;
+
+    public:
+        TokenView(const Vector<String>& args) noexcept : _strings(args.data()), _size(args.size()) {}
+        TokenView(int argc, char* const* argv) noexcept : _argv(argv), _size(argc > 0 ? static_cast<size_t>(argc) : 0) {}
+
+        inline std::string_view operator[](size_t i) const noexcept {
+            return _strings ? std::string_view(_strings[i]) : std::string_view(_argv[i]);
+        }
+
+        inline size_t size() const noexcept {
+            return _size;
+        }
+    };
+
+    /*------------------------------*\
+    | SeenSet:                       |
+    | Bitset of provided ids. Inline |
+    | up to `inline_bits`, one heap  |
+    | block beyond that.             |
+    \*------------------------------*/
+    class SeenSet {
+    public:
+        static constexpr size_t inline_bits = 256;
+
+    private:
+        std::array<uint64_t, inline_bits / 64> _inline{};
+        Vector<uint64_t> _heap;
+
+        inline uint64_t* words() noexcept {
+            return _heap.empty() ? _inline.data() : _heap.data();
+        }
+
+        inline const uint64_t* words() const noexcept {
+            return _heap.empty() ? _inline.data() : _heap.data();
+        }
+
+    public:
+        explicit SeenSet(size_t bits = 0) {
+            reset(bits);
+        }
+
+        /** @brief Clears every bit for a set of `bits` bits. A heap block, once grown, is kept and reused. */
+        inline void reset(size_t bits) {
+            if(bits > inline_bits) {
+                _heap.assign((bits + 63) / 64, 0);
+            } else {
+                _heap.clear();
+                _inline.fill(0);
+            }
+        }
+
+        inline bool test(size_t i) const noexcept {
+            return (words()[i / 64] >> (i % 64)) & 1u;
+        }
+
+        /** @brief Sets bit `i`. Returns true if it was already set. */
+        inline bool set(size_t i) noexcept {
+            uint64_t mask = uint64_t(1) << (i % 64);
+            uint64_t& word = words()[i / 64];
+            bool was_set = (word & mask) != 0;
+            word |= mask;
+            return was_set;
+        }
+    };
+
+} // namespace clab
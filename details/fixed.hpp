@@ -0,0 +1,706 @@
+/*---------------------------------------------------------------*\
+| CLAB - Command Line Arguments Builder                           |
+|                                                                 |
+| File: fixed.hpp                                                 |
+| Description:                                                    |
+|     Embedded mode. A builder and evaluation with fixed capacity |
+|     chosen by template parameters: no heap allocation, errors   |
+|     reported as codes. Parses exactly like `CLAB::evaluate`.    |
+|     Stand-alone: includes neither `clab.hpp` nor any container. |
+|                                                                 |
+| Minimum Standard: ISO C++17                                     |
+| License: MIT (c) 2025                                           |
+\*---------------------------------------------------------------*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <string_view>
+
+namespace clab {
+
+    /** @brief Error codes of the embedded mode, one per exception type of `CLAB`. */
+    enum class ErrorCode : uint8_t {
+        None,
+        Capacity,           // a fixed capacity is exhausted, `Status::subject` names which
+        InvalidBuilding,
+        MissingArgument,
+        InvalidValue,
+        UnexpectedArgument,
+        RedundantArgument,
+        TokenMismatch,
+        MissingValue
+    };
+
+    /** @brief Returns the name of the exception `CLAB` throws for `code`. */
+    inline constexpr const char* error_name(ErrorCode code) noexcept {
+        switch(code) {
+            case ErrorCode::None:               return "None";
+            case ErrorCode::Capacity:           return "Capacity";
+            case ErrorCode::InvalidBuilding:    return "InvalidBuilding";
+            case ErrorCode::MissingArgument:    return "MissingArgument";
+            case ErrorCode::InvalidValue:       return "InvalidValue";
+            case ErrorCode::UnexpectedArgument: return "UnexpectedArgument";
+            case ErrorCode::RedundantArgument:  return "RedundantArgument";
+            case ErrorCode::TokenMismatch:      return "TokenMismatch";
+            case ErrorCode::MissingValue:       return "MissingValue";
+        }
+        return "Unknown";
+    }
+
+    /*------------------------------*\
+    | Status:                        |
+    | Error code plus what `CLAB`    |
+    | would put in the message (an   |
+    | id or a token).                |
+    \*------------------------------*/
+    struct Status {
+        ErrorCode code = ErrorCode::None;
+        std::string_view subject{};
+
+        inline constexpr bool ok() const noexcept {
+            return code == ErrorCode::None;
+        }
+    };
+
+    template<size_t MaxFlags, size_t MaxTags, size_t MaxValues, size_t MaxBytes>
+    class FixedCLAB;
+
+    /*------------------------------*\
+    | FixedEvaluation:               |
+    | States and values by id slot,  |
+    | values as views into the input |
+    | or the schema.                 |
+    \*------------------------------*/
+    template<size_t MaxFlags, size_t MaxValues>
+    class FixedEvaluation {
+        template<size_t, size_t, size_t, size_t>
+        friend class FixedCLAB;
+
+    public:
+        static constexpr size_t npos = static_cast<size_t>(-1);
+        static constexpr uint32_t no_token = static_cast<uint32_t>(-1);
+
+    private:
+        static constexpr uint32_t none = static_cast<uint32_t>(-1);
+
+        struct Value {
+            std::string_view text;
+            uint32_t token; // index in the input, `no_token` for defaults
+            uint32_t next;
+        };
+
+        struct Slot {
+            uint32_t head = none;
+            uint32_t tail = none;
+            uint32_t count = 0;
+            bool state = false;
+        };
+
+        std::array<std::string_view, MaxFlags> _ids{};
+        std::array<Slot, MaxFlags> _slots{};
+        std::array<Value, MaxValues> _values{};
+        size_t _slot_count = 0;
+        size_t _value_count = 0;
+        uint32_t _abort_slot = none;
+        Status _status{};
+
+        inline void reset(size_t slot_count) noexcept {
+            _slot_count = slot_count;
+            for(size_t slot = 0; slot < slot_count; ++slot)
+                _slots[slot] = Slot{};
+            _value_count = 0;
+            _abort_slot = none;
+            _status = {};
+        }
+
+        inline bool add_param_at(size_t slot, std::string_view v, uint32_t token) noexcept {
+            if(_value_count == MaxValues)
+                return false;
+
+            uint32_t idx = static_cast<uint32_t>(_value_count++);
+            _values[idx] = Value{ v, token, none };
+            Slot& s = _slots[slot];
+            if(s.tail == none)
+                s.head = idx;
+            else
+                _values[s.tail].next = idx;
+            s.tail = idx;
+            s.count++;
+            return true;
+        }
+
+        /* Unlinks the values of `slot`; their entries stay used until the next parse. */
+        inline void clear_params_at(size_t slot) noexcept {
+            Slot& s = _slots[slot];
+            s.head = s.tail = none;
+            s.count = 0;
+        }
+
+        inline Status fail(Status status) noexcept {
+            _status = status;
+            return status;
+        }
+
+    public:
+        /*------------------------------*\
+        | Values:                        |
+        | Forward range over the values  |
+        | of one id, in input order.     |
+        \*------------------------------*/
+        class Values {
+            const Value* _values = nullptr;
+            uint32_t _head = none;
+            uint32_t _tail = none;
+            uint32_t _count = 0;
+
+        public:
+            class const_iterator {
+                const Value* _values;
+                uint32_t _idx;
+
+            public:
+                const_iterator(const Value* values, uint32_t idx) noexcept : _values(values), _idx(idx) {}
+
+                inline std::string_view operator*() const noexcept { return _values[_idx].text; }
+                inline uint32_t token() const noexcept { return _values[_idx].token; }
+
+                inline const_iterator& operator++() noexcept {
+                    _idx = _values[_idx].next;
+                    return *this;
+                }
+
+                inline bool operator==(const const_iterator& o) const noexcept { return _idx == o._idx; }
+                inline bool operator!=(const const_iterator& o) const noexcept { return _idx != o._idx; }
+            };
+
+            Values() noexcept = default;
+            Values(const Value* values, const Slot& s) noexcept
+                : _values(values), _head(s.head), _tail(s.tail), _count(s.count) {}
+
+            inline size_t size() const noexcept { return _count; }
+            inline bool empty() const noexcept { return _count == 0; }
+
+            /** @note Undefined on an empty list, like `ValueList`. */
+            inline std::string_view front() const noexcept { return _values[_head].text; }
+            inline std::string_view back() const noexcept { return _values[_tail].text; }
+
+            inline const_iterator begin() const noexcept { return const_iterator(_values, _head); }
+            inline const_iterator end() const noexcept { return const_iterator(_values, none); }
+        };
+
+        /** @brief Result of the parse that filled this evaluation. */
+        inline const Status& status() const noexcept {
+            return _status;
+        }
+
+        inline bool ok() const noexcept {
+            return _status.ok();
+        }
+
+        /** @brief Returns the slot of `id`, or `npos` if the schema doesn't declare it. */
+        inline size_t slot_of(std::string_view id) const noexcept {
+            for(size_t slot = 0; slot < _slot_count; ++slot) {
+                if(_ids[slot] == id)
+                    return slot;
+            }
+            return npos;
+        }
+
+        /** @brief Returns the boolean state of a flag. Returns false if not found. */
+        inline bool state(std::string_view id) const noexcept {
+            size_t slot = slot_of(id);
+            return slot != npos && _slots[slot].state;
+        }
+
+        inline bool state_at(size_t slot) const noexcept {
+            return _slots[slot].state;
+        }
+
+        /** @brief Returns all values associated with an ID. Returns an empty list if none. */
+        inline Values list(std::string_view id) const noexcept {
+            size_t slot = slot_of(id);
+            return slot == npos ? Values() : list_at(slot);
+        }
+
+        /** @brief Same as `list`, under the name `clab::Evaluation` gives its view. */
+        inline Values values(std::string_view id) const noexcept {
+            return list(id);
+        }
+
+        inline Values list_at(size_t slot) const noexcept {
+            return Values(_values.data(), _slots[slot]);
+        }
+
+        /** @brief Returns the last value added to a flag. Returns an empty view if none. */
+        inline std::string_view value(std::string_view id) const noexcept {
+            Values all = list(id);
+            return all.empty() ? std::string_view() : all.back();
+        }
+
+        /** @brief Checks if the parsing was aborted by a specific flag. */
+        inline bool aborted() const noexcept {
+            return _abort_slot != none;
+        }
+
+        /** @brief Returns the ID of the flag that caused the abort, empty if none. */
+        inline std::string_view aborted_id() const noexcept {
+            return aborted() ? _ids[_abort_slot] : std::string_view();
+        }
+    };
+
+    /*------------------------------*\
+    | FixedCLAB:                     |
+    | Builder of the embedded mode.  |
+    | Ids, tags and values live in   |
+    | one byte array of `MaxBytes`.  |
+    \*------------------------------*/
+    template<size_t MaxFlags, size_t MaxTags, size_t MaxValues, size_t MaxBytes>
+    class FixedCLAB {
+    public:
+        using Evaluation = FixedEvaluation<MaxFlags, MaxValues>;
+        using Action = void (*)(std::string_view); // must not throw
+
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+    private:
+        struct Text {
+            uint32_t offset = 0;
+            uint32_t size = 0;
+        };
+
+        struct Range {
+            uint32_t first = 0;
+            uint32_t count = 0;
+        };
+
+        struct Tag {
+            Text full;              // prefix + tag, compared as one token
+            uint32_t prefix_size;
+            uint32_t flag;
+            bool toggle_val;
+        };
+
+        enum FlagBit : uint8_t {
+            bit_required = 1 << 0,
+            bit_multiple = 1 << 1,
+            bit_abort    = 1 << 2,
+            bit_over     = 1 << 3,
+            bit_default  = 1 << 4,
+            bit_tagged   = 1 << 5
+        };
+
+        struct Flag {
+            Text id;
+            uint32_t slot = 0;
+            uint32_t consumed_args = 0;
+            Range defaults;
+            Range allowed;
+            Action action = nullptr;
+            uint8_t bits = 0;
+        };
+
+        std::array<char, MaxBytes> _bytes{};
+        std::array<Flag, MaxFlags> _flags{};
+        std::array<Tag, MaxTags> _tags{};       // sorted by flag, so the first match is the first declared flag
+        std::array<Text, MaxValues> _lists{};   // defaults and allowed values, contiguous per flag
+        size_t _byte_count = 0;
+        size_t _flag_count = 0;
+        size_t _tag_count = 0;
+        size_t _list_count = 0;
+        size_t _slot_count = 0;
+        Status _build{};                        // first building error, sticky
+
+        inline std::string_view text(Text t) const noexcept {
+            return std::string_view(_bytes.data() + t.offset, t.size);
+        }
+
+        inline bool fail(ErrorCode code, std::string_view subject) noexcept {
+            if(_build.ok())
+                _build = { code, subject };
+            return false;
+        }
+
+        inline bool store(std::string_view a, std::string_view b, Text& out) noexcept {
+            if(MaxBytes - _byte_count < a.size() + b.size())
+                return fail(ErrorCode::Capacity, "bytes");
+            out = { static_cast<uint32_t>(_byte_count), static_cast<uint32_t>(a.size() + b.size()) };
+            if(!a.empty())
+                std::memcpy(_bytes.data() + _byte_count, a.data(), a.size());
+            if(!b.empty())
+                std::memcpy(_bytes.data() + _byte_count + a.size(), b.data(), b.size());
+            _byte_count += a.size() + b.size();
+            return true;
+        }
+
+        /* Appends to the list `r`, moving it to the end of `_lists` first if another list follows it. */
+        inline bool append(Range& r, std::string_view v) noexcept {
+            Text t;
+            if(r.count > 0 && r.first + r.count != _list_count) {
+                if(MaxValues - _list_count < r.count)
+                    return fail(ErrorCode::Capacity, "values");
+                for(uint32_t i = 0; i < r.count; ++i)
+                    _lists[_list_count + i] = _lists[r.first + i];
+                r.first = static_cast<uint32_t>(_list_count);
+                _list_count += r.count;
+            }
+            if(_list_count == MaxValues)
+                return fail(ErrorCode::Capacity, "values");
+            if(!store(v, {}, t))
+                return false;
+            if(r.count == 0)
+                r.first = static_cast<uint32_t>(_list_count);
+            _lists[_list_count++] = t;
+            r.count++;
+            return true;
+        }
+
+        inline void set_tag(size_t flag_idx, std::string_view tag, std::string_view pref, bool val) noexcept {
+            Text full;
+            if(!store(pref, tag, full))
+                return;
+
+            // one entry per tag string, like the tag map of `CLAB`: redeclaring it replaces prefix and toggle
+            size_t pos = 0;
+            while(pos < _tag_count && _tags[pos].flag <= flag_idx) {
+                const Tag& t = _tags[pos];
+                if(t.flag == flag_idx && text(t.full).substr(t.prefix_size) == tag) {
+                    _tags[pos] = Tag{ full, static_cast<uint32_t>(pref.size()), static_cast<uint32_t>(flag_idx), val };
+                    return;
+                }
+                ++pos;
+            }
+
+            if(_tag_count == MaxTags) {
+                fail(ErrorCode::Capacity, "tags");
+                return;
+            }
+            for(size_t i = _tag_count; i > pos; --i)
+                _tags[i] = _tags[i - 1];
+            _tags[pos] = Tag{ full, static_cast<uint32_t>(pref.size()), static_cast<uint32_t>(flag_idx), val };
+            _tag_count++;
+            _flags[flag_idx].bits |= bit_tagged;
+        }
+
+        inline size_t find_match(std::string_view arg, bool& out_toggle) const noexcept {
+            for(size_t i = 0; i < _tag_count; ++i) {
+                const Tag& t = _tags[i];
+                if(t.full.size == arg.size() && std::memcmp(_bytes.data() + t.full.offset, arg.data(), arg.size()) == 0) {
+                    out_toggle = t.toggle_val;
+                    return t.flag;
+                }
+            }
+            return npos;
+        }
+
+        inline bool is_tag(std::string_view arg) const noexcept {
+            bool d = false;
+            return find_match(arg, d) != npos;
+        }
+
+        /* First positional still able to take a value, from `cursor` on: see `CLAB::find_positional`. */
+        inline size_t find_positional(const bool* provided, size_t& cursor) const noexcept {
+            for(; cursor < _flag_count; ++cursor) {
+                const Flag& flag = _flags[cursor];
+                if(!(flag.bits & bit_tagged) && ((flag.bits & bit_multiple) || !provided[flag.slot]))
+                    return cursor;
+            }
+            return npos;
+        }
+
+        inline Status validate_and_store(const Flag& flag, std::string_view val, size_t token, Evaluation& eval) const noexcept {
+            if(flag.allowed.count > 0) {
+                bool found = false;
+                for(uint32_t i = 0; i < flag.allowed.count && !found; ++i)
+                    found = text(_lists[flag.allowed.first + i]) == val;
+                if(!found)
+                    return { ErrorCode::InvalidValue, val };
+            }
+
+            if(!eval.add_param_at(flag.slot, val, static_cast<uint32_t>(token)))
+                return { ErrorCode::Capacity, "values" };
+            if(flag.action)
+                flag.action(val);
+            return {};
+        }
+
+        template<class Tokens>
+        inline Status handle_tagged_token(size_t flag_idx, bool toggle, const Tokens& args,
+            size_t& idx, Evaluation& eval, bool* provided) const noexcept {
+            const Flag& flag = _flags[flag_idx];
+            bool already_seen = provided[flag.slot];
+            provided[flag.slot] = true;
+            if(already_seen && !(flag.bits & bit_multiple))
+                return { ErrorCode::RedundantArgument, text(flag.id) };
+
+            if(!already_seen && flag.consumed_args > 0 && !(flag.bits & bit_over))
+                eval.clear_params_at(flag.slot);
+
+            eval._slots[flag.slot].state = toggle;
+            idx++;
+
+            for(size_t i = 0; i < flag.consumed_args; ++i) {
+                if(idx >= args.size())
+                    return { ErrorCode::MissingValue, text(flag.id) };
+
+                std::string_view val = args[idx];
+                if(is_tag(val))
+                    return { ErrorCode::TokenMismatch, val };
+
+                Status status = validate_and_store(flag, val, idx++, eval);
+                if(!status.ok())
+                    return status;
+            }
+            return {};
+        }
+
+        template<class Tokens>
+        inline Status handle_positional_token(const Tokens& args, size_t& idx, Evaluation& eval,
+            bool* provided, size_t& positional_cursor) const noexcept {
+            size_t flag_idx = find_positional(provided, positional_cursor);
+            if(flag_idx == npos)
+                return { ErrorCode::UnexpectedArgument, std::string_view(args[idx]) };
+
+            const Flag& flag = _flags[flag_idx];
+            bool is_first = !provided[flag.slot];
+            bool is_multiple = (flag.bits & bit_multiple) != 0;
+            provided[flag.slot] = true;
+
+            if(is_first && (is_multiple || flag.consumed_args > 0) && !(flag.bits & bit_over))
+                eval.clear_params_at(flag.slot);
+
+            eval._slots[flag.slot].state = true;
+
+            if(is_multiple) {
+                while(idx < args.size() && !is_tag(args[idx])) {
+                    Status status = validate_and_store(flag, args[idx], idx, eval);
+                    if(!status.ok())
+                        return status;
+                    idx++;
+                }
+            } else {
+                for(size_t i = 0; i < flag.consumed_args; ++i) {
+                    if(idx >= args.size())
+                        return { ErrorCode::MissingValue, text(flag.id) };
+                    Status status = validate_and_store(flag, args[idx], idx, eval);
+                    if(!status.ok())
+                        return status;
+                    idx++;
+                }
+            }
+            return {};
+        }
+
+        /* Adapter giving argv the `size()` / `operator[]` of a token list. */
+        struct Argv {
+            char* const* argv;
+            size_t count;
+
+            inline size_t size() const noexcept { return count; }
+            inline std::string_view operator[](size_t i) const noexcept { return argv[i]; }
+        };
+
+    public:
+        struct FlagConfigurator {
+            FixedCLAB& parent;
+            size_t index; // npos once a capacity ran out, every call is then a no-op
+
+            inline FlagConfigurator& action(Action fn) noexcept {
+                if(index != npos)
+                    parent._flags[index].action = fn;
+                return *this;
+            }
+
+            inline FlagConfigurator& flag(std::string_view tag, std::string_view pref = "-") noexcept {
+                if(index != npos)
+                    parent.set_tag(index, tag, pref, true);
+                return *this;
+            }
+
+            inline FlagConfigurator& toggle(bool val, std::string_view tag, std::string_view pref = "-") noexcept {
+                if(index != npos)
+                    parent.set_tag(index, tag, pref, val);
+                return *this;
+            }
+
+            inline FlagConfigurator& initial(bool val) noexcept {
+                if(index != npos)
+                    parent._flags[index].bits = static_cast<uint8_t>(val
+                        ? parent._flags[index].bits | bit_default
+                        : parent._flags[index].bits & ~bit_default);
+                return *this;
+            }
+
+            inline FlagConfigurator& initial(std::string_view val) noexcept {
+                return initial({ val });
+            }
+
+            inline FlagConfigurator& initial(const char* val) noexcept {
+                return initial(std::string_view(val));
+            }
+
+            inline FlagConfigurator& initial(std::initializer_list<std::string_view> vals) noexcept {
+                if(index == npos)
+                    return *this;
+                parent._flags[index].defaults.count = 0;
+                for(std::string_view v : vals)
+                    parent.append(parent._flags[index].defaults, v);
+                return *this;
+            }
+
+            inline FlagConfigurator& consume(size_t n) noexcept {
+                if(index != npos)
+                    parent._flags[index].consumed_args = static_cast<uint32_t>(n);
+                return *this;
+            }
+
+            inline FlagConfigurator& consume(size_t n, std::initializer_list<std::string_view> allowed) noexcept {
+                consume(n);
+                if(index != npos) {
+                    for(std::string_view v : allowed)
+                        parent.append(parent._flags[index].allowed, v);
+                }
+                return *this;
+            }
+
+            inline FlagConfigurator& required() noexcept {
+                if(index != npos)
+                    parent._flags[index].bits |= bit_required;
+                return *this;
+            }
+
+            inline FlagConfigurator& multiple() noexcept {
+                if(index != npos)
+                    parent._flags[index].bits |= bit_multiple;
+                return *this;
+            }
+
+            inline FlagConfigurator& abort() noexcept {
+                if(index != npos)
+                    parent._flags[index].bits |= bit_abort;
+                return *this;
+            }
+
+            inline FlagConfigurator& over() noexcept {
+                if(index != npos)
+                    parent._flags[index].bits |= bit_over | bit_multiple;
+                return *this;
+            }
+
+            inline FixedCLAB& end() noexcept {
+                if(index == npos)
+                    return parent;
+                const Flag& f = parent._flags[index];
+                if(!(f.bits & bit_tagged) && (f.bits & bit_multiple) && f.consumed_args > 0)
+                    parent.fail(ErrorCode::InvalidBuilding, parent.text(f.id));
+                return parent;
+            }
+        };
+
+        FixedCLAB() noexcept = default;
+
+        /** @brief Begins the configuration of a new argument. Ids repeated across flags share a slot. */
+        inline FlagConfigurator start(std::string_view id = "") noexcept {
+            if(_flag_count == MaxFlags) {
+                fail(ErrorCode::Capacity, "flags");
+                return { *this, npos };
+            }
+
+            Flag flag;
+            flag.slot = static_cast<uint32_t>(_slot_count);
+            for(size_t i = 0; i < _flag_count; ++i) {
+                if(text(_flags[i].id) == id) {
+                    flag.slot = _flags[i].slot;
+                    break;
+                }
+            }
+            if(!store(id, {}, flag.id))
+                return { *this, npos };
+            if(flag.slot == _slot_count)
+                _slot_count++;
+
+            _flags[_flag_count] = flag;
+            return { *this, _flag_count++ };
+        }
+
+        /** @brief First building error (capacity or `InvalidBuilding`), `ok()` if none. */
+        inline const Status& status() const noexcept {
+            return _build;
+        }
+
+        /** @brief Bytes of ids, tags and values stored so far, to size `MaxBytes`. */
+        inline size_t bytes_used() const noexcept {
+            return _byte_count;
+        }
+
+        /*
+        ** @brief Parses `args` into `out` with the semantics of `CLAB::evaluate(args)`.
+        ** @param args Anything with `size()` and `operator[]` convertible to `std::string_view`,
+        **             e.g. `std::vector<std::string>`. Values in `out` are views into `args` and
+        **             into this builder: both must outlive `out`.
+        ** @return `out.status()`: the code of the exception `evaluate` would throw (subject is its
+        **         message), or `Capacity` if `out` ran out of values. `out` is partly filled then.
+        */
+        template<class Tokens>
+        inline Status evaluate(const Tokens& args, Evaluation& out) const noexcept {
+            std::array<bool, MaxFlags> provided{};
+            size_t arg_idx = 0;
+            size_t positional_cursor = 0;
+
+            out.reset(_slot_count);
+            if(!_build.ok())
+                return out.fail(_build);
+
+            for(size_t flag_idx = 0; flag_idx < _flag_count; ++flag_idx) {
+                const Flag& flag = _flags[flag_idx];
+                out._ids[flag.slot] = text(flag.id);
+                out._slots[flag.slot].state = (flag.bits & bit_default) != 0;
+                for(uint32_t i = 0; i < flag.defaults.count; ++i) {
+                    if(!out.add_param_at(flag.slot, text(_lists[flag.defaults.first + i]), Evaluation::no_token))
+                        return out.fail({ ErrorCode::Capacity, "values" });
+                }
+            }
+
+            for(size_t i = 0; i < args.size(); ++i) {
+                bool toggle = false;
+                size_t flag_idx = find_match(args[i], toggle);
+                if(flag_idx == npos || !(_flags[flag_idx].bits & bit_abort))
+                    continue;
+
+                const Flag& flag = _flags[flag_idx];
+                out._abort_slot = flag.slot;
+                out._slots[flag.slot].state = toggle;
+                if(flag.action)
+                    flag.action("");
+                return {};
+            }
+
+            while(arg_idx < args.size()) {
+                bool toggle = true;
+                size_t flag_idx = find_match(args[arg_idx], toggle);
+
+                Status status = flag_idx != npos
+                    ? handle_tagged_token(flag_idx, toggle, args, arg_idx, out, provided.data())
+                    : handle_positional_token(args, arg_idx, out, provided.data(), positional_cursor);
+                if(!status.ok())
+                    return out.fail(status);
+            }
+
+            for(size_t flag_idx = 0; flag_idx < _flag_count; ++flag_idx) {
+                const Flag& flag = _flags[flag_idx];
+                if((flag.bits & bit_required) && !provided[flag.slot])
+                    return out.fail({ ErrorCode::MissingArgument, text(flag.id) });
+            }
+            return {};
+        }
+
+        inline Status evaluate(int argc, char* const* argv, Evaluation& out) const noexcept {
+            return evaluate(Argv{ argv, argc > 0 ? static_cast<size_t>(argc) : 0 }, out);
+        }
+    };
+
+} // namespace clab
@@ -0,0 +1,293 @@
+/*---------------------------------------------------------------*\
+| CLAB - Command Line Arguments Builder                           |
+|                                                                 |
+| File: image.hpp                                                 |
+| Description:                                                    |
+|     Schema images. Writes a built schema as a flat binary file  |
+|     and decodes it at startup instead of running the builder    |
+|     and its validation, with version and checksum checks so a   |
+|     stale image falls back to the builder. Opt-in: include this |
+|     header explicitly.                                          |
+|                                                                 |
+| Minimum Standard: ISO C++17                                     |
+| License: MIT (c) 2025                                           |
+\*---------------------------------------------------------------*/
+
+#pragma once
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include "../clab.hpp"
+
+namespace clab {
+
+    /*------------------------------*\
+    | SchemaImage:                   |
+    | Saves and loads the flags,     |
+    | prefixes and finalized state   |
+    | of a builder.                  |
+    \*------------------------------*/
+    class SchemaImage {
+    public:
+        static constexpr uint32_t format_version = 1;
+
+    private:
+        static constexpr char magic[8] = { 'C', 'L', 'A', 'B', 'I', 'M', 'G', '\0' };
+        static constexpr uint32_t byte_order = 0x01020304;
+
+        struct Header {
+            char magic[8];
+            uint32_t format_version;
+            uint32_t byte_order;      // images are native endian, this rejects foreign ones
+            uint64_t schema_version;  // chosen by the caller, e.g. a hash of the spec the CLI is generated from
+            uint64_t payload_size;
+            uint64_t checksum;        // FNV-1a of the payload
+        };
+
+        enum FlagBit : uint8_t {
+            bit_required = 1 << 0,
+            bit_multiple = 1 << 1,
+            bit_abort    = 1 << 2,
+            bit_over     = 1 << 3,
+            bit_default  = 1 << 4
+        };
+
+        static inline uint64_t checksum(const char* data, size_t size) noexcept {
+            uint64_t h = 14695981039346656037ull;
+            for(size_t i = 0; i < size; ++i)
+                h = (h ^ static_cast<unsigned char>(data[i])) * 1099511628211ull;
+            return h;
+        }
+
+        /*------------------------------*\
+        | Writer / Reader:               |
+        | Length-prefixed strings and    |
+        | native integers. The reader    |
+        | fails instead of overrunning.  |
+        \*------------------------------*/
+        struct Writer {
+            String out;
+
+            inline void u8(uint8_t v) { out.push_back(static_cast<char>(v)); }
+            inline void u32(uint32_t v) { out.append(reinterpret_cast<const char*>(&v), sizeof(v)); }
+            inline void str(std::string_view s) {
+                u32(static_cast<uint32_t>(s.size()));
+                out.append(s.data(), s.size());
+            }
+        };
+
+        struct Reader {
+            const char* pos;
+            const char* end;
+
+            inline bool u8(uint8_t& v) noexcept {
+                if(end - pos < 1)
+                    return false;
+                v = static_cast<uint8_t>(*pos++);
+                return true;
+            }
+
+            inline bool u32(uint32_t& v) noexcept {
+                if(end - pos < static_cast<std::ptrdiff_t>(sizeof(v)))
+                    return false;
+                std::memcpy(&v, pos, sizeof(v));
+                pos += sizeof(v);
+                return true;
+            }
+
+            inline bool str(std::string_view& s) noexcept {
+                uint32_t size = 0;
+                if(!u32(size) || static_cast<size_t>(end - pos) < size)
+                    return false;
+                s = std::string_view(pos, size);
+                pos += size;
+                return true;
+            }
+        };
+
+        /* Reads the whole file at `path`; empty if it can't be read. */
+        static inline String read_file(const String& path) {
+            std::ifstream file(path, std::ios::binary);
+            if(!file)
+                return {};
+            return String(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+
+        static inline void write_flag(Writer& w, const CLAB::FlagConfig& flag) {
+            w.str(flag.id);
+            w.u32(static_cast<uint32_t>(flag.consumed_args));
+            w.u8(static_cast<uint8_t>(
+                  (flag.is_required    ? bit_required : 0)
+                | (flag.is_multiple    ? bit_multiple : 0)
+                | (flag.is_abort       ? bit_abort    : 0)
+                | (flag.is_over        ? bit_over     : 0)
+                | (flag.default_toggle ? bit_default  : 0)));
+
+            w.u32(static_cast<uint32_t>(flag.tags.size()));
+            for(const std::pair<const String, CLAB::TagInfo>& tag_info : flag.tags) {
+                w.str(tag_info.first);
+                w.u32(tag_info.second.prefix);
+                w.u8(tag_info.second.toggle_val ? 1 : 0);
+            }
+
+            w.u32(static_cast<uint32_t>(flag.default_params.size()));
+            for(const String& val : flag.default_params)
+                w.str(val);
+
+            w.u32(static_cast<uint32_t>(flag.allowed_params.size()));
+            for(const String& val : flag.allowed_params)
+                w.str(val);
+        }
+
+        static inline bool read_flag(Reader& r, CLAB& out, CLAB::FlagConfig& flag) {
+            std::string_view text;
+            uint32_t count = 0;
+            uint8_t bits = 0;
+
+            if(!r.str(text) || !r.u32(count) || !r.u8(bits))
+                return false;
+            flag.id = String(text);
+            flag.slot = out.id_names->intern(text);
+            flag.consumed_args = count;
+            flag.is_required    = (bits & bit_required) != 0;
+            flag.is_multiple    = (bits & bit_multiple) != 0;
+            flag.is_abort       = (bits & bit_abort) != 0;
+            flag.is_over        = (bits & bit_over) != 0;
+            flag.default_toggle = (bits & bit_default) != 0;
+
+            if(!r.u32(count))
+                return false;
+            flag.tags.reserve(count);
+            for(uint32_t i = 0; i < count; ++i) {
+                uint32_t prefix = 0;
+                uint8_t toggle = 0;
+                if(!r.str(text) || !r.u32(prefix) || !r.u8(toggle) || prefix >= out.prefix_names.size())
+                    return false;
+                flag.tags.emplace(String(text), CLAB::TagInfo{ prefix, toggle != 0 });
+            }
+
+            if(!r.u32(count))
+                return false;
+            flag.default_params.reserve(count);
+            for(uint32_t i = 0; i < count; ++i) {
+                if(!r.str(text))
+                    return false;
+                flag.default_params.emplace_back(text);
+            }
+
+            if(!r.u32(count))
+                return false;
+            flag.allowed_params.reserve(count);
+            for(uint32_t i = 0; i < count; ++i) {
+                if(!r.str(text))
+                    return false;
+                flag.allowed_params.emplace(text);
+            }
+            return true;
+        }
+
+        static inline bool decode(Reader r, CLAB& out) {
+            uint32_t count = 0;
+            std::string_view text;
+
+            if(!r.u32(count))
+                return false;
+            for(uint32_t i = 0; i < count; ++i) {
+                if(!r.str(text) || out.prefix_names.intern(text) != i)
+                    return false;
+            }
+
+            if(!r.u32(count))
+                return false;
+            out.flags_vector.reserve(count);
+            out.id_names->reserve(count);
+            for(uint32_t i = 0; i < count; ++i) {
+                if(!read_flag(r, out, out.flags_vector.emplace_back()))
+                    return false;
+                out.hot_consume.push_back(0);
+                out.hot_slot.push_back(0);
+                out.hot_bits.push_back(0);
+                out.sync_hot(i);
+            }
+
+            uint8_t finalized = 0;
+            if(!r.u8(finalized) || r.pos != r.end)
+                return false;
+            if(finalized)
+                out.build_index(false); // validated by finalize() before it was saved
+            return true;
+        }
+
+    public:
+        /*
+        ** @brief Writes the schema of `parser` (flags, prefixes, finalized state) to `path`.
+        ** @param schema_version Stored as is; `load` rejects the image unless it gets the same value.
+        ** @note Usage counters and options such as `record_order()` are not part of the image.
+        ** @throws Exception if a flag has an action: actions can't be stored.
+        ** @return false if the file can't be written.
+        */
+        static inline bool save(const CLAB& parser, const String& path, uint64_t schema_version = 0) {
+            Writer w;
+            w.u32(static_cast<uint32_t>(parser.prefix_names.size()));
+            for(uint32_t i = 0; i < parser.prefix_names.size(); ++i)
+                w.str(parser.prefix_names[i]);
+
+            w.u32(static_cast<uint32_t>(parser.flags_vector.size()));
+            for(const CLAB::FlagConfig& flag : parser.flags_vector) {
+                if(flag.action)
+                    throw Exception("Cannot store the action of argument '" + flag.id + "' in a schema image.");
+                write_flag(w, flag);
+            }
+            w.u8(parser.frozen ? 1 : 0);
+
+            Header header{};
+            std::memcpy(header.magic, magic, sizeof(magic));
+            header.format_version = format_version;
+            header.byte_order = byte_order;
+            header.schema_version = schema_version;
+            header.payload_size = w.out.size();
+            header.checksum = checksum(w.out.data(), w.out.size());
+
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            if(!file)
+                return false;
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(w.out.data(), static_cast<std::streamsize>(w.out.size()));
+            return static_cast<bool>(file);
+        }
+
+        /*
+        ** @brief Reads the image at `path` and replaces `out` with the schema it holds.
+        ** @note The schema is trusted: a finalized image is indexed without re-validating it.
+        ** @note Every string is copied into `out`, which owns its flags, so the file is read once
+        **       into memory rather than mapped.
+        ** @return false, leaving `out` untouched, if the file is missing, corrupt, of another
+        **         format or byte order, or saved with a different `schema_version`; build the
+        **         schema normally (and `save` it again) in that case.
+        */
+        static inline bool load(CLAB& out, const String& path, uint64_t schema_version = 0) {
+            String file = read_file(path);
+            if(file.size() < sizeof(Header))
+                return false;
+
+            Header header;
+            std::memcpy(&header, file.data(), sizeof(header));
+            const char* payload = file.data() + sizeof(Header);
+            if(std::memcmp(header.magic, magic, sizeof(magic)) != 0
+                || header.format_version != format_version
+                || header.byte_order != byte_order
+                || header.schema_version != schema_version
+                || header.payload_size != file.size() - sizeof(Header)
+                || header.checksum != checksum(payload, header.payload_size))
+                return false;
+
+            CLAB loaded;
+            if(!decode(Reader{ payload, payload + header.payload_size }, loaded))
+                return false;
+            out = std::move(loaded);
+            return true;
+        }
+    };
+
+} // namespace clab
@@ -0,0 +1,159 @@
+/*---------------------------------------------------------------*\
+| CLAB - Command Line Arguments Builder                           |
+|                                                                 |
+| File: index.hpp                                                 |
+| Description:                                                    |
+|     Flat open-addressing tables from tags to flags, grouped by  |
+|     prefix. Looked up with string views, so matching a token    |
+|     never allocates.                                            |
+|                                                                 |
+| Minimum Standard: ISO C++17                                     |
+| License: MIT (c) 2025                                           |
+\*---------------------------------------------------------------*/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include "types.hpp"
+
+namespace clab {
+
+    /*------------------------------*\
+    | TagIndex:                      |
+    | Linear probing, power of two   |
+    | capacity, at most half full.   |
+    \*------------------------------*/
+    class TagIndex {
+    public:
+        struct Entry {
+            String key{};
+            size_t hash = 0;
+            size_t flag = 0;
+            bool toggle = true;
+            bool used = false;
+        };
+
+    private:
+        Vector<Entry> _slots;
+        size_t _size = 0;
+
+        static inline size_t hash_of(std::string_view key) noexcept {
+            return std::hash<std::string_view>{}(key);
+        }
+
+        inline void grow() {
+            Vector<Entry> old = std::move(_slots);
+            _slots.assign(old.empty() ? 16 : old.size() * 2, Entry{});
+            for(Entry& e : old) {
+                if(!e.used)
+                    continue;
+                size_t mask = _slots.size() - 1;
+                size_t i = e.hash & mask;
+                while(_slots[i].used)
+                    i = (i + 1) & mask;
+                _slots[i] = std::move(e);
+            }
+        }
+
+    public:
+        /** @brief Inserts `key`. Returns the existing entry instead if the key is already present. */
+        inline const Entry* insert(String key, size_t flag, bool toggle) {
+            if(const Entry* existing = find(key))
+                return existing;
+
+            if((_size + 1) * 2 > _slots.size())
+                grow();
+
+            size_t hash = hash_of(key);
+            size_t mask = _slots.size() - 1;
+            size_t i = hash & mask;
+            while(_slots[i].used)
+                i = (i + 1) & mask;
+
+            _slots[i] = { std::move(key), hash, flag, toggle, true };
+            _size++;
+            return nullptr;
+        }
+
+        inline const Entry* find(std::string_view key) const noexcept {
+            if(_slots.empty())
+                return nullptr;
+
+            size_t hash = hash_of(key);
+            size_t mask = _slots.size() - 1;
+            for(size_t i = hash & mask; _slots[i].used; i = (i + 1) & mask) {
+                if(_slots[i].hash == hash && _slots[i].key == key)
+                    return &_slots[i];
+            }
+            return nullptr;
+        }
+
+        inline size_t size() const noexcept {
+            return _size;
+        }
+
+        inline bool empty() const noexcept {
+            return _size == 0;
+        }
+
+        inline void clear() noexcept {
+            _slots.clear();
+            _size = 0;
+        }
+    };
+
+    /*------------------------------*\
+    | PrefixIndex:                   |
+    | One TagIndex per distinct      |
+    | prefix, longest prefix first.  |
+    \*------------------------------*/
+    class PrefixIndex {
+        struct Group {
+            String prefix;
+            TagIndex tags; // keyed by the tag without the prefix
+        };
+
+        Vector<Group> _groups;
+
+    public:
+        /** @brief Returns the tag table of `prefix`, adding an empty one if needed. */
+        inline TagIndex& group(std::string_view prefix) {
+            auto it = _groups.begin();
+            for(; it != _groups.end() && it->prefix.size() >= prefix.size(); ++it) {
+                if(it->prefix == prefix)
+                    return it->tags;
+            }
+            return _groups.insert(it, Group{ String(prefix), TagIndex{} })->tags;
+        }
+
+        /*
+        ** @brief Strips each prefix `token` starts with, longest first, and looks the rest up in its table.
+        ** @note Returns the first hit. `CLAB::finalize()` rejects tags spelled by two prefixes, so there is at most one.
+        */
+        inline const TagIndex::Entry* find(std::string_view token) const noexcept {
+            for(const Group& g : _groups) {
+                if(token.size() < g.prefix.size() || token.compare(0, g.prefix.size(), g.prefix) != 0)
+                    continue;
+                if(const TagIndex::Entry* entry = g.tags.find(token.substr(g.prefix.size())))
+                    return entry;
+            }
+            return nullptr;
+        }
+
+        /** @brief Number of distinct prefixes. */
+        inline size_t size() const noexcept {
+            return _groups.size();
+        }
+
+        inline bool empty() const noexcept {
+            return _groups.empty();
+        }
+
+        inline void clear() noexcept {
+            _groups.clear();
+        }
+    };
+
+} // namespace clab
@@ -0,0 +1,138 @@
+/*---------------------------------------------------------------*\
+| CLAB - Command Line Arguments Builder                           |
+|                                                                 |
+| File: intern.hpp                                                |
+| Description:                                                    |
+|     String interning pool. Each distinct string is stored once  |
+|     and referred to by a dense 32-bit id.                       |
+|                                                                 |
+| Minimum Standard: ISO C++17                                     |
+| License: MIT (c) 2025                                           |
+\*---------------------------------------------------------------*/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include "types.hpp"
+
+namespace clab {
+
+    /*------------------------------*\
+    | StringPool:                    |
+    | Strings by id, plus an open-   |
+    | addressing table of ids for    |
+    | lookups by content.            |
+    \*------------------------------*/
+    class StringPool {
+    public:
+        static constexpr uint32_t npos = UINT32_MAX;
+
+    private:
+        Vector<String> _strings;  // the first `_count` are live, the rest keep their capacity for reuse
+        Vector<size_t> _hashes;   // parallel to `_strings`
+        Vector<uint32_t> _table;  // ids, `npos` when empty; power of two, at most half full
+        size_t _count = 0;
+        bool _indexed = true;
+
+        static inline size_t hash_of(std::string_view s) noexcept {
+            return std::hash<std::string_view>{}(s);
+        }
+
+        inline void place(uint32_t id) noexcept {
+            size_t mask = _table.size() - 1;
+            size_t i = _hashes[id] & mask;
+            while(_table[i] != npos)
+                i = (i + 1) & mask;
+            _table[i] = id;
+        }
+
+        inline void grow() {
+            _table.assign(_table.empty() ? 16 : _table.size() * 2, npos);
+            for(uint32_t id = 0; id < _count; ++id)
+                place(id);
+        }
+
+        inline uint32_t find(std::string_view s, size_t hash) const noexcept {
+            if(_table.empty())
+                return npos;
+
+            size_t mask = _table.size() - 1;
+            for(size_t i = hash & mask; _table[i] != npos; i = (i + 1) & mask) {
+                uint32_t id = _table[i];
+                if(_hashes[id] == hash && _strings[id] == s)
+                    return id;
+            }
+            return npos;
+        }
+
+        inline uint32_t append(std::string_view s) {
+            if(_count < _strings.size())
+                _strings[_count].assign(s.data(), s.size());
+            else
+                _strings.emplace_back(s);
+            return static_cast<uint32_t>(_count++);
+        }
+
+    public:
+        /** @param indexed When false, strings are only appended: `intern` never deduplicates and `find` always misses. */
+        explicit StringPool(bool indexed = true) noexcept : _indexed(indexed) {}
+
+        /** @brief Returns the id of `s`, adding it if it isn't in the pool yet. */
+        inline uint32_t intern(std::string_view s) {
+            if(!_indexed)
+                return append(s);
+
+            size_t hash = hash_of(s);
+            uint32_t id = find(s, hash);
+            if(id != npos)
+                return id;
+
+            id = append(s);
+            if(id < _hashes.size())
+                _hashes[id] = hash;
+            else
+                _hashes.push_back(hash);
+            if(_count * 2 > _table.size())
+                grow();
+            else
+                place(id);
+            return id;
+        }
+
+        /** @brief Returns the id of `s`, or `npos` if it was never interned. */
+        inline uint32_t find(std::string_view s) const noexcept {
+            return find(s, hash_of(s));
+        }
+
+        inline const String& operator[](uint32_t id) const noexcept {
+            return _strings[id];
+        }
+
+        inline bool indexed() const noexcept {
+            return _indexed;
+        }
+
+        inline size_t size() const noexcept {
+            return _count;
+        }
+
+        inline bool empty() const noexcept {
+            return _count == 0;
+        }
+
+        /** @brief Empties the pool but keeps every buffer, so refilling it allocates nothing new. */
+        inline void clear() noexcept {
+            _count = 0;
+            _table.assign(_table.size(), npos);
+        }
+
+        inline void reserve(size_t n) {
+            _strings.reserve(n);
+            if(_indexed)
+                _hashes.reserve(n);
+        }
+    };
+
+} // namespace clab
@@ -0,0 +1,174 @@
+/*---------------------------------------------------------------*\
+| CLAB - Command Line Arguments Builder                           |
+|                                                                 |
+| File: live.hpp                                                  |
+| Description:                                                    |
+|     Read-copy-update publication of a builder. Parses run on an |
+|     immutable version read through an atomic pointer while a    |
+|     new one is built and swapped in; writers wait for a grace   |
+|     period before freeing the old one. Opt-in: include this     |
+|     header explicitly.                                          |
+|                                                                 |
+| Minimum Standard: ISO C++17                                     |
+| License: MIT (c) 2025                                           |
+\*---------------------------------------------------------------*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include "../clab.hpp"
+#include "usage.hpp"
+
+namespace clab {
+
+    /*------------------------------*\
+    | LiveCLAB:                      |
+    | Atomically published builder.  |
+    | Readers never lock or wait;    |
+    | writers wait for the readers   |
+    | of the version they retire.    |
+    \*------------------------------*/
+    class LiveCLAB {
+    public:
+        static constexpr size_t reader_slots = 64;
+
+    private:
+        /*
+        ** Readers count themselves in the slot of their thread, under the parity of the epoch
+        ** they entered in. A writer swaps the pointer, flips the epoch and waits for the old
+        ** parity to drain: new readers count under the new parity, so it can't be starved.
+        */
+        struct alignas(cache_line_size) ReaderSlot {
+            std::atomic<uint64_t> readers[2] = { {0}, {0} };
+        };
+
+        std::atomic<const CLAB*> _current;
+        std::atomic<uint64_t> _epoch{0};
+        mutable std::array<ReaderSlot, reader_slots> _slots{};
+        // Serializes `publish` and `update` so concurrent edits are not lost. Never taken by readers.
+        std::mutex _writers;
+
+        static inline size_t thread_slot() noexcept {
+            static std::atomic<size_t> next{0};
+            static thread_local size_t slot = next.fetch_add(1, std::memory_order_relaxed) % reader_slots;
+            return slot;
+        }
+
+        /* Swaps in `next` and frees the previous version once no reader can hold it. `_writers` is held. */
+        inline void swap_locked(const CLAB* next) {
+            const CLAB* old = _current.exchange(next);
+            uint64_t parity = _epoch.fetch_add(1) & 1;
+            for(ReaderSlot& slot : _slots) {
+                while(slot.readers[parity].load() != 0)
+                    std::this_thread::yield();
+            }
+            delete old;
+        }
+
+    public:
+        /*------------------------------*\
+        | Snapshot:                      |
+        | Read section pinning the       |
+        | published version.             |
+        \*------------------------------*/
+        class Snapshot {
+            const CLAB* _version = nullptr;
+            std::atomic<uint64_t>* _count = nullptr;
+
+        public:
+            explicit Snapshot(const LiveCLAB& live) noexcept {
+                ReaderSlot& slot = live._slots[thread_slot()];
+                _count = &slot.readers[live._epoch.load() & 1];
+                _count->fetch_add(1);
+                _version = live._current.load(); // after the count: a writer that missed it swapped first
+            }
+
+            ~Snapshot() {
+                if(_count)
+                    _count->fetch_sub(1, std::memory_order_release);
+            }
+
+            Snapshot(Snapshot&& other) noexcept : _version(other._version), _count(other._count) {
+                other._count = nullptr;
+            }
+
+            Snapshot(const Snapshot&) = delete;
+            Snapshot& operator=(const Snapshot&) = delete;
+            Snapshot& operator=(Snapshot&&) = delete;
+
+            inline const CLAB& operator*() const noexcept { return *_version; }
+            inline const CLAB* operator->() const noexcept { return _version; }
+        };
+
+        explicit LiveCLAB(CLAB initial = CLAB()) : _current(new CLAB(std::move(initial))) {}
+
+        ~LiveCLAB() {
+            delete _current.load();
+        }
+
+        LiveCLAB(const LiveCLAB&) = delete;
+        LiveCLAB& operator=(const LiveCLAB&) = delete;
+
+        /*
+        ** @brief Returns the published version, valid for as long as the snapshot lives even if a
+        **        newer version is published meanwhile.
+        ** @note Two atomic increments on a per-thread cache line, no lock. A writer retiring this
+        **       version waits for the snapshot to end, so don't keep one across long waits, and
+        **       don't call `publish` or `update` from a thread holding one.
+        */
+        inline Snapshot snapshot() const noexcept {
+            return Snapshot(*this);
+        }
+
+        inline Evaluation evaluate(const Vector<String>& args) const {
+            return snapshot()->evaluate(args);
+        }
+
+        inline Evaluation evaluate(int argc, char* argv[]) const {
+            return snapshot()->evaluate(argc, argv);
+        }
+
+        /*
+        ** @brief Parses into `out`, reusing its storage (see `CLAB::evaluate(args, out)`).
+        ** @note Unlike `evaluate(args)`, no reference count is touched while the version in `out`
+        **       stays the published one, so readers share no cache line.
+        */
+        inline void evaluate(const Vector<String>& args, Evaluation& out) const {
+            snapshot()->evaluate(args, out);
+        }
+
+        /*
+        ** @brief Swaps in `next`. Returns once no parse can still be running on the previous
+        **        version, which is then freed.
+        ** @note Serialized with `update`, so an update never publishes over a concurrent publish.
+        */
+        inline void publish(CLAB next) {
+            const CLAB* version = new CLAB(std::move(next));
+            std::lock_guard<std::mutex> lock(_writers);
+            swap_locked(version);
+        }
+
+        /*
+        ** @brief Copies the published version, lets `edit` modify the copy and publishes it.
+        ** @note `edit` runs outside of any reader path; concurrent `update` and `publish` calls
+        **       are serialized.
+        ** @note If the published version was finalized, the copy is unfrozen for `edit` and
+        **       finalized again before being published.
+        */
+        template<class Edit>
+        inline void update(Edit&& edit) {
+            std::lock_guard<std::mutex> lock(_writers);
+            CLAB next(*_current.load()); // writers are serialized: nothing can retire it meanwhile
+            bool finalized = next.is_finalized();
+            next.unfreeze();
+            edit(next);
+            if(finalized && !next.is_finalized())
+                next.finalize();
+            swap_locked(new CLAB(std::move(next)));
+        }
+    };
+
+} // namespace clab
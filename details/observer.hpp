@@ -0,0 +1,211 @@
+/*---------------------------------------------------------------*\
+| CLAB - Command Line Arguments Builder                           |
+|                                                                 |
+| File: observer.hpp                                              |
+| Description:                                                    |
+|     Optional parse observers. The default `NullObserver` is     |
+|     compiled away; `Metrics` records per-phase timings and      |
+|     counters that can be exported for scraping.                 |
+|                                                                 |
+| Minimum Standard: ISO C++17                                     |
+| License: MIT (c) 2025                                           |
+\*---------------------------------------------------------------*/
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+#include "types.hpp"
+
+namespace clab {
+
+    /*------------------------------*\
+    | Phase:                         |
+    | The stages of `evaluate`.      |
+    \*------------------------------*/
+    enum class Phase : size_t {
+        InitializeDefaults,
+        CheckForAbort,
+        TokenLoop,
+        VerifyRequired,
+        Actions,
+        Lookup,         // one token-to-flag lookup, only for observers with `token_phases`
+        Store,          // one value stored, only for observers with `token_phases`
+        Count
+    };
+
+    /** @brief Returns the snake_case name of a phase, as used in exported counters. */
+    inline const char* phase_name(Phase p) noexcept {
+        switch(p) {
+            case Phase::InitializeDefaults: return "initialize_defaults";
+            case Phase::CheckForAbort:      return "check_for_abort";
+            case Phase::TokenLoop:          return "token_loop";
+            case Phase::VerifyRequired:     return "verify_required_flags";
+            case Phase::Actions:            return "actions";
+            case Phase::Lookup:             return "lookup";
+            case Phase::Store:              return "store";
+            default:                        return "unknown";
+        }
+    }
+
+    /*------------------------------*\
+    | NullObserver:                  |
+    | Default observer. Every hook   |
+    | is a no-op and `enabled` lets  |
+    | the engine skip the clocks.    |
+    \*------------------------------*/
+    struct NullObserver {
+        static constexpr bool enabled = false;
+
+        inline void phase(Phase, std::chrono::nanoseconds) noexcept {}
+        inline void tag_lookup() noexcept {}
+        inline void value_stored() noexcept {}
+        inline void value_growth() noexcept {}
+    };
+
+    /*------------------------------*\
+    | Metrics:                       |
+    | Accumulating observer. Not     |
+    | synchronized: use one per      |
+    | thread and `merge` them.       |
+    \*------------------------------*/
+    class Metrics {
+    public:
+        static constexpr bool enabled = true;
+
+        struct PhaseStats {
+            uint64_t calls = 0;
+            uint64_t nanoseconds = 0;
+        };
+
+        using Counter = std::pair<String, uint64_t>;
+
+    private:
+        std::array<PhaseStats, static_cast<size_t>(Phase::Count)> _phases{};
+        uint64_t _tag_lookups = 0;
+        uint64_t _values_stored = 0;
+        uint64_t _value_growths = 0;
+
+    public:
+        inline void phase(Phase p, std::chrono::nanoseconds d) noexcept {
+            PhaseStats& s = _phases[static_cast<size_t>(p)];
+            s.calls++;
+            s.nanoseconds += static_cast<uint64_t>(d.count());
+        }
+
+        inline void tag_lookup() noexcept { _tag_lookups++; }
+        inline void value_stored() noexcept { _values_stored++; }
+        inline void value_growth() noexcept { _value_growths++; }
+
+        /** @brief Returns the accumulated calls and time of a phase. */
+        inline const PhaseStats& stats(Phase p) const noexcept {
+            return _phases[static_cast<size_t>(p)];
+        }
+
+        /** @brief Number of token-to-flag lookups performed. */
+        inline uint64_t tag_lookups() const noexcept { return _tag_lookups; }
+
+        /** @brief Number of values stored into evaluations. */
+        inline uint64_t values_stored() const noexcept { return _values_stored; }
+
+        /*
+        ** @brief Stored values that grew the evaluation: the value list of the flag reallocated, or a
+        **        value longer than the small-string buffer was copied into the value pool.
+        ** @note Not a heap call count: other allocations of a parse are not seen here. Count those
+        **       with details/alloc.hpp.
+        */
+        inline uint64_t value_growths() const noexcept { return _value_growths; }
+
+        /** @brief Adds the counters of another instance into this one. */
+        inline Metrics& merge(const Metrics& other) noexcept {
+            for(size_t i = 0; i < _phases.size(); ++i) {
+                _phases[i].calls += other._phases[i].calls;
+                _phases[i].nanoseconds += other._phases[i].nanoseconds;
+            }
+            _tag_lookups += other._tag_lookups;
+            _values_stored += other._values_stored;
+            _value_growths += other._value_growths;
+            return *this;
+        }
+
+        inline void reset() noexcept {
+            *this = Metrics{};
+        }
+
+        /** @brief Flattens every counter into `name -> value` pairs. */
+        inline Vector<Counter> counters() const {
+            Vector<Counter> out;
+            for(size_t i = 0; i < _phases.size(); ++i) {
+                String name = phase_name(static_cast<Phase>(i));
+                out.emplace_back(name + "_calls", _phases[i].calls);
+                out.emplace_back(name + "_nanoseconds", _phases[i].nanoseconds);
+            }
+            out.emplace_back("tag_lookups", _tag_lookups);
+            out.emplace_back("values_stored", _values_stored);
+            out.emplace_back("value_growths", _value_growths);
+            return out;
+        }
+
+        /** @brief Writes the counters in the Prometheus text exposition format. */
+        inline void write_text(std::ostream& os, const String& ns = "clab") const {
+            for(const Counter& c : counters()) {
+                os << "# TYPE " << ns << '_' << c.first << "_total counter\n";
+                os << ns << '_' << c.first << "_total " << c.second << '\n';
+            }
+        }
+    };
+
+    /* Observers may also define `phase_begin(Phase)`, called before the clock starts. */
+    template<class Observer, class = void>
+    struct HasPhaseBegin : std::false_type {};
+
+    template<class Observer>
+    struct HasPhaseBegin<Observer, std::void_t<decltype(std::declval<Observer&>().phase_begin(Phase::Count))>> : std::true_type {};
+
+    /*
+    ** Observers may also define `static constexpr bool token_phases = true` to get `Phase::Lookup`
+    ** and `Phase::Store` around every lookup and stored value. Off by default: two clock reads per
+    ** token would dwarf the work they measure.
+    */
+    template<class Observer, class = void>
+    struct HasTokenPhases : std::false_type {};
+
+    template<class Observer>
+    struct HasTokenPhases<Observer, std::enable_if_t<Observer::token_phases>> : std::true_type {};
+
+    /*------------------------------*\
+    | PhaseTimer:                    |
+    | Scoped clock reporting into an |
+    | observer. Empty when disabled. |
+    \*------------------------------*/
+    template<class Observer, bool Active = Observer::enabled>
+    class PhaseTimer {
+        using Clock = std::chrono::steady_clock;
+
+        Observer& _obs;
+        Phase _phase;
+        Clock::time_point _start{};
+
+    public:
+        inline PhaseTimer(Observer& obs, Phase p) noexcept : _obs(obs), _phase(p) {
+            if constexpr(Active) {
+                if constexpr(HasPhaseBegin<Observer>::value)
+                    _obs.phase_begin(p);
+                _start = Clock::now();
+            }
+        }
+
+        inline ~PhaseTimer() {
+            if constexpr(Active)
+                _obs.phase(_phase, std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - _start));
+        }
+
+        PhaseTimer(const PhaseTimer&) = delete;
+        PhaseTimer& operator=(const PhaseTimer&) = delete;
+    };
+
+} // namespace clab
@@ -0,0 +1,395 @@
+/*---------------------------------------------------------------*\
+| CLAB - Command Line Arguments Builder                           |
+|                                                                 |
+| File: perf.hpp                                                  |
+| Description:                                                    |
+|     Hardware counters. An observer reading cycles, instructions,|
+|     cache and branch misses around every phase of `evaluate`    |
+|     through Linux perf events; falls back to timings only where |
+|     they are not allowed. Opt-in: include this header explicitly.|
+|                                                                 |
+| Minimum Standard: ISO C++17                                     |
+| License: MIT (c) 2025                                           |
+\*---------------------------------------------------------------*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include "observer.hpp"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace clab {
+
+    /*------------------------------*\
+    | PerfEvent:                     |
+    | The hardware counters read.    |
+    \*------------------------------*/
+    enum class PerfEvent : size_t {
+        Cycles,
+        Instructions,
+        L1dMisses,      // L1 data cache read misses
+        LlcMisses,      // last level cache misses
+        BranchMisses,
+        Count
+    };
+
+    /** @brief Returns the snake_case name of a counter, as used in exported counters. */
+    inline const char* perf_event_name(PerfEvent e) noexcept {
+        switch(e) {
+            case PerfEvent::Cycles:       return "cycles";
+            case PerfEvent::Instructions: return "instructions";
+            case PerfEvent::L1dMisses:    return "l1d_misses";
+            case PerfEvent::LlcMisses:    return "llc_misses";
+            case PerfEvent::BranchMisses: return "branch_misses";
+            default:                      return "unknown";
+        }
+    }
+
+    /*------------------------------*\
+    | PerfCounters:                  |
+    | One perf event group for the   |
+    | calling thread, read with a    |
+    | single syscall.                |
+    \*------------------------------*/
+    class PerfCounters {
+    public:
+        static constexpr size_t count = static_cast<size_t>(PerfEvent::Count);
+        using Sample = std::array<uint64_t, count>;
+
+        /* Raw counts with the time the group was enabled and actually counting. */
+        struct Reading {
+            Sample values{};
+            uint64_t time_enabled = 0;
+            uint64_t time_running = 0; // below `time_enabled` when the kernel multiplexed the group
+        };
+
+        /** @brief Extrapolates `value`, counted during `running` of `enabled` ns, to the whole `enabled` time. */
+        static inline uint64_t scale(uint64_t value, uint64_t enabled, uint64_t running) noexcept {
+            if(running == 0)
+                return 0;
+            if(running >= enabled)
+                return value;
+            return static_cast<uint64_t>(static_cast<long double>(value) * enabled / running);
+        }
+
+    private:
+        std::array<int, count> _fds;
+        std::array<size_t, count> _position; // index in the group read, `count` if the event didn't open
+        size_t _opened = 0;
+
+#if defined(__linux__)
+        static inline int open_event(uint32_t type, uint64_t config, int group) noexcept {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = type;
+            attr.config = config;
+            attr.disabled = group < 0 ? 1 : 0;
+            attr.exclude_kernel = 1; // allowed with perf_event_paranoid up to 2
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            return static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, group, 0));
+        }
+#endif
+
+    public:
+        /** @brief Opens the counters; any that the kernel, the CPU or the sandbox refuses is skipped. */
+        PerfCounters() noexcept {
+            _fds.fill(-1);
+            _position.fill(count);
+#if defined(__linux__)
+            const std::array<std::pair<uint32_t, uint64_t>, count> events = {{
+                { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+                { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+                { PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D
+                    | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+                { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+                { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES }
+            }};
+
+            int leader = -1;
+            for(size_t e = 0; e < count; ++e) {
+                int fd = open_event(events[e].first, events[e].second, leader);
+                if(fd < 0)
+                    continue;
+                if(leader < 0)
+                    leader = fd;
+                _fds[e] = fd;
+                _position[e] = _opened++;
+            }
+
+            if(leader >= 0) {
+                ::ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+                ::ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+            }
+#endif
+        }
+
+        ~PerfCounters() {
+#if defined(__linux__)
+            for(int fd : _fds) {
+                if(fd >= 0)
+                    ::close(fd);
+            }
+#endif
+        }
+
+        PerfCounters(const PerfCounters&) = delete;
+        PerfCounters& operator=(const PerfCounters&) = delete;
+
+        /** @brief False when no counter could be opened (not Linux, no PMU, or perf events not allowed). */
+        inline bool available() const noexcept {
+            return _opened > 0;
+        }
+
+        inline bool available(PerfEvent e) const noexcept {
+            return _position[static_cast<size_t>(e)] != count;
+        }
+
+        /** @brief Reads every counter, unscaled; counters that didn't open read 0. Returns false on failure. */
+        inline bool read(Reading& out) const noexcept {
+            out = Reading{};
+#if defined(__linux__)
+            if(!available())
+                return false;
+
+            uint64_t buffer[3 + count]; // nr, time enabled, time running, values
+            int leader = -1;
+            for(int fd : _fds) {
+                if(fd >= 0) {
+                    leader = fd;
+                    break;
+                }
+            }
+            ssize_t size = ::read(leader, buffer, sizeof(buffer));
+            if(size < static_cast<ssize_t>(sizeof(uint64_t) * (3 + _opened)) || buffer[0] != _opened)
+                return false;
+
+            out.time_enabled = buffer[1];
+            out.time_running = buffer[2];
+            for(size_t e = 0; e < count; ++e) {
+                if(_position[e] != count)
+                    out.values[e] = buffer[3 + _position[e]];
+            }
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        /*
+        ** @brief Reads every counter, scaled to the time the group was enabled if it was multiplexed.
+        ** @note Counters that didn't open read 0. Returns false on failure.
+        */
+        inline bool read(Sample& out) const noexcept {
+            Reading r;
+            bool ok = read(r);
+            for(size_t e = 0; e < count; ++e)
+                out[e] = scale(r.values[e], r.time_enabled, r.time_running);
+            return ok;
+        }
+    };
+
+    /*------------------------------*\
+    | PerfMetrics:                   |
+    | `Metrics` plus the hardware    |
+    | counters of every phase. Same  |
+    | threading rules as `Metrics`.  |
+    \*------------------------------*/
+    class PerfMetrics {
+    public:
+        static constexpr bool enabled = true;
+        static constexpr bool token_phases = true; // also `Phase::Lookup` and `Phase::Store`
+
+        using Sample = PerfCounters::Sample;
+        using Reading = PerfCounters::Reading;
+
+    private:
+        static constexpr size_t phase_count = static_cast<size_t>(Phase::Count);
+
+        /* A phase being measured. Its counts pause while a nested phase runs. */
+        struct Active {
+            size_t phase = 0;
+            Reading start{};      // start of the current segment
+            Sample counts{};      // segments so far, scaled
+            uint64_t nested = 0;  // nested phases, each costing one more counter read
+            bool valid = false;
+        };
+
+        PerfCounters _counters;
+        Metrics _metrics;
+        std::array<Active, phase_count> _active{};
+        size_t _depth = 0;
+        Sample _read_cost{};  // counts of one counter read, taken off every measurement
+        std::array<Sample, phase_count> _totals{};
+        uint64_t _failed_reads = 0;
+        uint64_t _segments = 0;
+        uint64_t _scaled_segments = 0;
+
+        /* Smallest counts seen between two back-to-back reads: what one read adds to a measurement. */
+        inline void calibrate() noexcept {
+            if(!_counters.available())
+                return;
+
+            _read_cost.fill(UINT64_MAX);
+            for(int i = 0; i < 16; ++i) {
+                Reading a, b;
+                if(!_counters.read(a) || !_counters.read(b)) {
+                    _read_cost.fill(0);
+                    return;
+                }
+                for(size_t e = 0; e < PerfCounters::count; ++e)
+                    _read_cost[e] = std::min(_read_cost[e], b.values[e] - a.values[e]);
+            }
+        }
+
+        inline void add_segment(Active& a, const Reading& now) noexcept {
+            uint64_t enabled_ns = now.time_enabled - a.start.time_enabled;
+            uint64_t running_ns = now.time_running - a.start.time_running;
+            _segments++;
+            _scaled_segments += running_ns < enabled_ns ? 1 : 0;
+            for(size_t e = 0; e < PerfCounters::count; ++e)
+                a.counts[e] += PerfCounters::scale(now.values[e] - a.start.values[e], enabled_ns, running_ns);
+        }
+
+    public:
+        PerfMetrics() noexcept {
+            calibrate();
+        }
+
+        inline void phase_begin(Phase p) noexcept {
+            Reading now;
+            bool ok = _counters.read(now);
+            if(_depth > 0) {
+                Active& outer = _active[_depth - 1];
+                if(outer.valid && ok)
+                    add_segment(outer, now);
+                outer.valid = outer.valid && ok;
+                outer.nested++;
+            }
+            if(_depth < _active.size())
+                _active[_depth++] = { static_cast<size_t>(p), now, {}, 0, ok };
+        }
+
+        inline void phase(Phase p, std::chrono::nanoseconds d) noexcept {
+            size_t i = static_cast<size_t>(p);
+            _metrics.phase(p, d);
+            if(_depth == 0 || _active[_depth - 1].phase != i)
+                return;
+
+            Active& a = _active[--_depth];
+            Reading now;
+            bool ok = a.valid && _counters.read(now);
+            if(ok) {
+                add_segment(a, now);
+                for(size_t e = 0; e < PerfCounters::count; ++e) {
+                    uint64_t cost = _read_cost[e] * (1 + a.nested);
+                    _totals[i][e] += a.counts[e] > cost ? a.counts[e] - cost : 0;
+                }
+            } else {
+                _failed_reads += _counters.available() ? 1 : 0;
+            }
+
+            if(_depth > 0) {
+                Active& outer = _active[_depth - 1];
+                outer.start = now;
+                outer.valid = outer.valid && ok;
+            }
+        }
+
+        inline void tag_lookup() noexcept { _metrics.tag_lookup(); }
+        inline void value_stored() noexcept { _metrics.value_stored(); }
+        inline void value_growth() noexcept { _metrics.value_growth(); }
+
+        /** @brief False when only timings are recorded, see `PerfCounters::available()`. */
+        inline bool available() const noexcept {
+            return _counters.available();
+        }
+
+        inline bool available(PerfEvent e) const noexcept {
+            return _counters.available(e);
+        }
+
+        /** @brief Timings and parse counters, as recorded by `Metrics`. */
+        inline const Metrics& metrics() const noexcept {
+            return _metrics;
+        }
+
+        /*
+        ** @brief Accumulated value of counter `e` over every call of phase `p`.
+        ** @note Exclusive: phases nested in `p` (lookups, stores and actions in the token loop) and
+        **       the counter reads around them are not included.
+        */
+        inline uint64_t total(Phase p, PerfEvent e) const noexcept {
+            return _totals[static_cast<size_t>(p)][static_cast<size_t>(e)];
+        }
+
+        /** @brief Phases whose counters could not be read, e.g. after the group was descheduled. */
+        inline uint64_t failed_reads() const noexcept {
+            return _failed_reads;
+        }
+
+        /** @brief Measured segments, and how many of them were scaled because the group was multiplexed. */
+        inline uint64_t segments() const noexcept {
+            return _segments;
+        }
+
+        inline uint64_t scaled_segments() const noexcept {
+            return _scaled_segments;
+        }
+
+        /** @brief Counts one counter read adds to a measurement, taken off every phase. */
+        inline const Sample& read_cost() const noexcept {
+            return _read_cost;
+        }
+
+        inline void reset() noexcept {
+            _metrics.reset();
+            _totals = {};
+            _depth = 0;
+            _failed_reads = 0;
+            _segments = 0;
+            _scaled_segments = 0;
+        }
+
+        /*
+        ** @brief Writes one line per phase: calls, nanoseconds and each counter, all per token.
+        ** @param tokens Tokens parsed while recording, e.g. `args.size()` times the runs.
+        */
+        inline void write_report(std::ostream& os, uint64_t tokens) const {
+            double per = tokens ? 1.0 / static_cast<double>(tokens) : 0.0;
+            if(!available())
+                os << "# perf events unavailable, timings only\n";
+            else if(_scaled_segments > 0)
+                os << "# counters multiplexed: " << _scaled_segments << " of " << _segments << " samples scaled\n";
+
+            os << "phase calls ns/token";
+            for(size_t e = 0; e < PerfCounters::count; ++e) {
+                if(available(static_cast<PerfEvent>(e)))
+                    os << ' ' << perf_event_name(static_cast<PerfEvent>(e)) << "/token";
+            }
+            os << '\n';
+
+            for(size_t i = 0; i < phase_count; ++i) {
+                const Metrics::PhaseStats& s = _metrics.stats(static_cast<Phase>(i));
+                os << phase_name(static_cast<Phase>(i)) << ' ' << s.calls << ' ' << static_cast<double>(s.nanoseconds) * per;
+                for(size_t e = 0; e < PerfCounters::count; ++e) {
+                    if(available(static_cast<PerfEvent>(e)))
+                        os << ' ' << static_cast<double>(_totals[i][e]) * per;
+                }
+                os << '\n';
+            }
+        }
+    };
+
+} // namespace clab
@@ -0,0 +1,70 @@
+/*---------------------------------------------------------------*\
+| CLAB - Command Line Arguments Builder                           |
+|                                                                 |
+| File: registry.hpp                                              |
+| Description:                                                    |
+|     Concurrent flag registration. Each plugin declares its      |
+|     flags into its own staging builder, from any thread, and a  |
+|     single `finalize` merges them. Opt-in: include explicitly.  |
+|                                                                 |
+| Minimum Standard: ISO C++17                                     |
+| License: MIT (c) 2025                                           |
+\*---------------------------------------------------------------*/
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include "../clab.hpp"
+
+namespace clab {
+
+    /*------------------------------*\
+    | FlagRegistry:                  |
+    | Named staging builders merged  |
+    | in name order on finalize.     |
+    \*------------------------------*/
+    class FlagRegistry {
+        std::map<String, std::unique_ptr<CLAB>> _stages;
+        mutable std::mutex _mutex;
+
+    public:
+        FlagRegistry() = default;
+        FlagRegistry(const FlagRegistry&) = delete;
+        FlagRegistry& operator=(const FlagRegistry&) = delete;
+
+        /*
+        ** @brief Returns the staging builder of `name`, creating it on first use.
+        ** @note Only this lookup is synchronized: different stages can be filled from different
+        **       threads at once, but a single stage must be filled by one thread at a time.
+        */
+        inline CLAB& stage(const String& name) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            std::unique_ptr<CLAB>& slot = _stages[name];
+            if(!slot)
+                slot = std::make_unique<CLAB>();
+            return *slot;
+        }
+
+        /*
+        ** @brief Merges every stage, in name order, into a new finalized builder.
+        ** @note Call once every registering thread is done. The stages are left untouched.
+        ** @throws InvalidBuilding on an id or tag declared twice (naming the stage when two
+        **         stages collide), or any other error of `CLAB::finalize`.
+        */
+        inline CLAB finalize() const {
+            std::lock_guard<std::mutex> lock(_mutex);
+            CLAB out;
+            for(const std::pair<const String, std::unique_ptr<CLAB>>& stage : _stages) {
+                try {
+                    out.merge(*stage.second);
+                } catch(const InvalidBuilding& e) {
+                    throw InvalidBuilding("Stage '" + stage.first + "': " + e.what());
+                }
+            }
+            out.finalize();
+            return out;
+        }
+    };
+
+} // namespace clab
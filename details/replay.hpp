@@ -0,0 +1,307 @@
+/*---------------------------------------------------------------*\
+| CLAB - Command Line Arguments Builder                           |
+|                                                                 |
+| File: replay.hpp                                                |
+| Description:                                                    |
+|     Corpus replay. Runs captured command lines (shell history,  |
+|     /proc/<pid>/cmdline) through `evaluate` and reports latency |
+|     percentiles, throughput and allocations, saved as a         |
+|     baseline to compare two builds of the library.              |
+|     Opt-in: include this header explicitly.                     |
+|                                                                 |
+| Minimum Standard: ISO C++17                                     |
+| License: MIT (c) 2025                                           |
+\*---------------------------------------------------------------*/
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <ostream>
+#include "../clab.hpp"
+#include "alloc.hpp"
+
+namespace clab {
+
+    /*------------------------------*\
+    | Corpus:                        |
+    | Command lines to replay, one   |
+    | argument vector each.          |
+    \*------------------------------*/
+    class Corpus {
+        Vector<Vector<String>> _lines;
+        size_t _tokens = 0;
+
+        /* Shell-like split: whitespace separates, '...' is literal, "..." and \ escape like sh. */
+        static inline Vector<String> split_shell(std::string_view line) {
+            Vector<String> args;
+            String current;
+            bool in_token = false;
+            char quote = 0;
+
+            for(size_t i = 0; i < line.size(); ++i) {
+                char c = line[i];
+                if(quote == '\'') {
+                    if(c == '\'')
+                        quote = 0;
+                    else
+                        current.push_back(c);
+                } else if(c == '\\' && i + 1 < line.size() && (quote == 0 || line[i + 1] == '"' || line[i + 1] == '\\')) {
+                    current.push_back(line[++i]);
+                    in_token = true;
+                } else if(quote == '"') {
+                    if(c == '"')
+                        quote = 0;
+                    else
+                        current.push_back(c);
+                } else if(c == '\'' || c == '"') {
+                    quote = c;
+                    in_token = true;
+                } else if(c == ' ' || c == '\t' || c == '\r') {
+                    if(in_token)
+                        args.push_back(std::move(current));
+                    current.clear();
+                    in_token = false;
+                } else {
+                    current.push_back(c);
+                    in_token = true;
+                }
+            }
+            if(in_token)
+                args.push_back(std::move(current));
+            return args;
+        }
+
+        /* /proc/<pid>/cmdline format: every argument ends with a NUL. */
+        static inline Vector<String> split_nul(std::string_view line) {
+            Vector<String> args;
+            size_t begin = 0;
+            while(begin < line.size()) {
+                size_t end = line.find('\0', begin);
+                if(end == std::string_view::npos)
+                    end = line.size();
+                args.emplace_back(line.substr(begin, end - begin));
+                begin = end + 1;
+            }
+            return args;
+        }
+
+    public:
+        /*
+        ** @brief Reads one command line per line of `path`. Lines holding a NUL are split on NULs
+        **        (`/proc/<pid>/cmdline` format), others like a shell would split them.
+        **        Empty lines and lines starting with `#` are skipped.
+        ** @note Records are always separated by newlines. A cmdline file has none, so a file made of
+        **       several must put each on its own line (e.g. `cat /proc/$pid/cmdline; echo`); plain
+        **       concatenation reads as one command line. A single cmdline file reads as is.
+        ** @param drop_program Drop the first argument of every line (the program name).
+        ** @throws Exception if the file can't be read.
+        */
+        static inline Corpus read(const String& path, bool drop_program = false) {
+            std::ifstream file(path, std::ios::binary);
+            if(!file)
+                throw Exception("Cannot read corpus file '" + path + "'.");
+
+            Corpus corpus;
+            String line;
+            while(std::getline(file, line)) {
+                if(line.empty() || line[0] == '#')
+                    continue;
+
+                Vector<String> args = line.find('\0') != String::npos ? split_nul(line) : split_shell(line);
+                if(drop_program && !args.empty())
+                    args.erase(args.begin());
+                corpus.add(std::move(args));
+            }
+            return corpus;
+        }
+
+        inline void add(Vector<String> args) {
+            _tokens += args.size();
+            _lines.push_back(std::move(args));
+        }
+
+        inline size_t size() const noexcept { return _lines.size(); }
+        inline bool empty() const noexcept { return _lines.empty(); }
+
+        /** @brief Total arguments over every line. */
+        inline size_t tokens() const noexcept { return _tokens; }
+
+        inline const Vector<String>& operator[](size_t i) const { return _lines[i]; }
+        inline Vector<Vector<String>>::const_iterator begin() const noexcept { return _lines.begin(); }
+        inline Vector<Vector<String>>::const_iterator end() const noexcept { return _lines.end(); }
+    };
+
+    /*------------------------------*\
+    | ReplayStats:                   |
+    | Result of a replay. Saved and  |
+    | loaded as `name value` lines.  |
+    \*------------------------------*/
+    struct ReplayStats {
+        uint64_t runs = 0;          // evaluate calls timed
+        uint64_t tokens = 0;        // arguments parsed by those calls
+        uint64_t errors = 0;        // calls that threw, also timed
+        double p50_ns = 0;
+        double p99_ns = 0;
+        double p999_ns = 0;
+        double max_ns = 0;
+        double mean_ns = 0;
+        double runs_per_second = 0;
+        double tokens_per_second = 0;
+        double allocations_per_run = 0; // heap calls per `evaluate`, see details/alloc.hpp
+        double bytes_per_run = 0;       // heap bytes requested per `evaluate`
+
+        /** @brief Every field as `name -> value`, in a fixed order. */
+        inline Vector<std::pair<String, double>> fields() const {
+            return {
+                { "runs", static_cast<double>(runs) },
+                { "tokens", static_cast<double>(tokens) },
+                { "errors", static_cast<double>(errors) },
+                { "p50_ns", p50_ns },
+                { "p99_ns", p99_ns },
+                { "p999_ns", p999_ns },
+                { "max_ns", max_ns },
+                { "mean_ns", mean_ns },
+                { "runs_per_second", runs_per_second },
+                { "tokens_per_second", tokens_per_second },
+                { "allocations_per_run", allocations_per_run },
+                { "bytes_per_run", bytes_per_run }
+            };
+        }
+
+        inline void write(std::ostream& os) const {
+            for(const std::pair<String, double>& f : fields())
+                os << f.first << ' ' << f.second << '\n';
+        }
+
+        /** @brief Saves the stats as a baseline. Returns false if the file can't be written. */
+        inline bool save(const String& path) const {
+            std::ofstream file(path);
+            if(!file)
+                return false;
+            file.precision(17);
+            file << "# clab-replay 1\n";
+            write(file);
+            return static_cast<bool>(file);
+        }
+
+        /** @brief Loads a baseline written by `save`. Unknown names are ignored. Returns false if unreadable. */
+        inline bool load(const String& path) {
+            std::ifstream file(path);
+            if(!file)
+                return false;
+
+            String name;
+            double value = 0;
+            String header;
+            std::getline(file, header);
+            if(header != "# clab-replay 1")
+                return false;
+
+            while(file >> name >> value) {
+                if(name == "runs") runs = static_cast<uint64_t>(value);
+                else if(name == "tokens") tokens = static_cast<uint64_t>(value);
+                else if(name == "errors") errors = static_cast<uint64_t>(value);
+                else if(name == "p50_ns") p50_ns = value;
+                else if(name == "p99_ns") p99_ns = value;
+                else if(name == "p999_ns") p999_ns = value;
+                else if(name == "max_ns") max_ns = value;
+                else if(name == "mean_ns") mean_ns = value;
+                else if(name == "runs_per_second") runs_per_second = value;
+                else if(name == "tokens_per_second") tokens_per_second = value;
+                else if(name == "allocations_per_run") allocations_per_run = value;
+                else if(name == "bytes_per_run") bytes_per_run = value;
+            }
+            return true;
+        }
+    };
+
+    /*
+    ** @brief Times `parser.evaluate(line)` for every line of `corpus`, `rounds` times.
+    ** @note Lines that throw count as errors and are timed too. Allocations come from one extra,
+    **       untimed round under `allocations_of`: they are the real heap calls and bytes, and stay
+    **       zero unless one TU of the program defines CLAB_COUNT_ALLOCATIONS (see details/alloc.hpp).
+    */
+    inline ReplayStats replay(const CLAB& parser, const Corpus& corpus, size_t rounds = 1) {
+        using Clock = std::chrono::steady_clock;
+
+        ReplayStats stats;
+        Vector<uint64_t> latencies;
+        latencies.reserve(corpus.size() * rounds);
+
+        Clock::time_point begin = Clock::now();
+        for(size_t round = 0; round < rounds; ++round) {
+            for(const Vector<String>& args : corpus) {
+                Clock::time_point start = Clock::now();
+                try {
+                    Evaluation eval = parser.evaluate(args);
+                    (void)eval;
+                } catch(const Exception&) {
+                    stats.errors++;
+                }
+                latencies.push_back(static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count()));
+            }
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+
+        AllocationCounts heap = allocations_of([&] {
+            for(const Vector<String>& args : corpus) {
+                try {
+                    Evaluation eval = parser.evaluate(args);
+                    (void)eval;
+                } catch(const Exception&) {
+                }
+            }
+        });
+
+        stats.runs = latencies.size();
+        stats.tokens = static_cast<uint64_t>(corpus.tokens()) * rounds;
+        if(latencies.empty())
+            return stats;
+
+        auto percentile = [&](double p) {
+            size_t rank = static_cast<size_t>(std::ceil(p * static_cast<double>(latencies.size())));
+            size_t idx = rank == 0 ? 0 : rank - 1;
+            std::nth_element(latencies.begin(), latencies.begin() + static_cast<std::ptrdiff_t>(idx), latencies.end());
+            return static_cast<double>(latencies[idx]);
+        };
+
+        double total = 0;
+        for(uint64_t ns : latencies)
+            total += static_cast<double>(ns);
+
+        stats.p50_ns = percentile(0.50);
+        stats.p99_ns = percentile(0.99);
+        stats.p999_ns = percentile(0.999);
+        stats.max_ns = static_cast<double>(*std::max_element(latencies.begin(), latencies.end()));
+        stats.mean_ns = total / static_cast<double>(latencies.size());
+        stats.runs_per_second = seconds > 0 ? static_cast<double>(stats.runs) / seconds : 0;
+        stats.tokens_per_second = seconds > 0 ? static_cast<double>(stats.tokens) / seconds : 0;
+        stats.allocations_per_run = static_cast<double>(heap.allocations) / static_cast<double>(corpus.size());
+        stats.bytes_per_run = static_cast<double>(heap.bytes) / static_cast<double>(corpus.size());
+        return stats;
+    }
+
+    /*
+    ** @brief Writes `name baseline current ratio` for every field, e.g. with a baseline saved by
+    **        another build of the library. A ratio above 1 means `current` is higher.
+    */
+    inline void compare(const ReplayStats& baseline, const ReplayStats& current, std::ostream& os) {
+        Vector<std::pair<String, double>> base = baseline.fields();
+        Vector<std::pair<String, double>> cur = current.fields();
+        os << "field baseline current ratio\n";
+        for(size_t i = 0; i < base.size(); ++i) {
+            os << base[i].first << ' ' << base[i].second << ' ' << cur[i].second << ' ';
+            if(base[i].second != 0)
+                os << cur[i].second / base[i].second;
+            else
+                os << '-';
+            os << '\n';
+        }
+    }
+
+} // namespace clab
@@ -0,0 +1,87 @@
+/*---------------------------------------------------------------*\
+| CLAB - Command Line Arguments Builder                           |
+|                                                                 |
+| File: usage.hpp                                                 |
+| Description:                                                    |
+|     Opt-in per-flag hit counters. One relaxed atomic per flag,  |
+|     each on its own cache line, safe under concurrent parses.   |
+|                                                                 |
+| Minimum Standard: ISO C++17                                     |
+| License: MIT (c) 2025                                           |
+\*---------------------------------------------------------------*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include "types.hpp"
+
+namespace clab {
+
+    /** @brief Assumed cache line size used to pad shared counters. */
+    constexpr size_t cache_line_size = 64;
+
+    /*------------------------------*\
+    | UsageCounters:                 |
+    | Fixed-size table of padded     |
+    | atomics indexed by flag.       |
+    \*------------------------------*/
+    class UsageCounters {
+        struct alignas(cache_line_size) Slot {
+            std::atomic<uint64_t> hits{0};
+        };
+
+        std::unique_ptr<Slot[]> _slots;
+        size_t _size = 0;
+
+    public:
+        explicit UsageCounters(size_t size) : _slots(new Slot[size]), _size(size) {}
+
+        UsageCounters(const UsageCounters&) = delete;
+        UsageCounters& operator=(const UsageCounters&) = delete;
+
+        /** @brief Records one occurrence of the flag at `idx`. */
+        inline void hit(size_t idx) noexcept {
+            if(idx < _size)
+                _slots[idx].hits.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /** @brief Adds `n` occurrences to the flag at `idx` (e.g. from a saved profile). */
+        inline void add(size_t idx, uint64_t n) noexcept {
+            if(idx < _size)
+                _slots[idx].hits.fetch_add(n, std::memory_order_relaxed);
+        }
+
+        /** @brief Returns the occurrences recorded for the flag at `idx`. */
+        inline uint64_t hits(size_t idx) const noexcept {
+            return idx < _size ? _slots[idx].hits.load(std::memory_order_relaxed) : 0;
+        }
+
+        inline size_t size() const noexcept {
+            return _size;
+        }
+
+        /** @brief Returns a copy of every counter. Each value is read independently. */
+        inline Vector<uint64_t> snapshot() const {
+            Vector<uint64_t> out(_size);
+            for(size_t i = 0; i < _size; ++i)
+                out[i] = hits(i);
+            return out;
+        }
+
+        inline void reset() noexcept {
+            for(size_t i = 0; i < _size; ++i)
+                _slots[i].hits.store(0, std::memory_order_relaxed);
+        }
+
+        /** @brief Returns a new table of `size` slots seeded with the current values. */
+        inline Shared<UsageCounters> grown(size_t size) const {
+            Shared<UsageCounters> out = std::make_shared<UsageCounters>(size);
+            for(size_t i = 0; i < _size && i < size; ++i)
+                out->add(i, hits(i));
+            return out;
+        }
+    };
+
+} // namespace clab
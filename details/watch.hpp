@@ -0,0 +1,190 @@
+/*---------------------------------------------------------------*\
+| CLAB - Command Line Arguments Builder                           |
+|                                                                 |
+| File: watch.hpp                                                 |
+| Description:                                                    |
+|     Argument files and hot reload. Reads whitespace separated   |
+|     arguments from a file and, on Linux, re-parses it through   |
+|     inotify reporting only the flags that changed.              |
+|     Opt-in: include this header explicitly.                     |
+|                                                                 |
+| Minimum Standard: ISO C++17                                     |
+| License: MIT (c) 2025                                           |
+\*---------------------------------------------------------------*/
+
+#pragma once
+
+#include <fstream>
+#include <iterator>
+#include "../clab.hpp"
+
+#if defined(__linux__)
+#include <cerrno>
+#include <climits>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace clab {
+
+    /*
+    ** @brief Reads an argument file: arguments split on whitespace, `"..."` groups one argument,
+    **        lines whose first non-blank character is `#` are comments.
+    ** @throws Exception if the file can't be read.
+    */
+    inline Vector<String> read_args_file(const String& path) {
+        std::ifstream file(path);
+        if(!file)
+            throw Exception("Cannot read argument file '" + path + "'.");
+
+        String text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        Vector<String> args;
+        String current;
+        bool in_token = false, quoted = false, line_start = true;
+
+        for(size_t i = 0; i < text.size(); ++i) {
+            char c = text[i];
+            if(line_start && !quoted && c == '#') {
+                while(i < text.size() && text[i] != '\n')
+                    ++i;
+                continue;
+            }
+            line_start = c == '\n' || (line_start && (c == ' ' || c == '\t' || c == '\r'));
+
+            if(c == '"') {
+                quoted = !quoted;
+                in_token = true;
+            } else if(!quoted && (c == ' ' || c == '\t' || c == '\n' || c == '\r')) {
+                if(in_token)
+                    args.push_back(std::move(current));
+                current.clear();
+                in_token = false;
+            } else {
+                current.push_back(c);
+                in_token = true;
+            }
+        }
+        if(in_token)
+            args.push_back(std::move(current));
+        return args;
+    }
+
+#if defined(__linux__)
+
+    /*------------------------------*\
+    | ArgsFileWatcher:               |
+    | Re-parses an argument file     |
+    | when it changes and reports    |
+    | the flags that differ.         |
+    \*------------------------------*/
+    class ArgsFileWatcher {
+        /* Owns the inotify descriptor, so a throwing constructor still closes it. */
+        struct Descriptor {
+            int fd;
+
+            explicit Descriptor(int f) noexcept : fd(f) {}
+            ~Descriptor() {
+                if(fd >= 0)
+                    ::close(fd);
+            }
+
+            Descriptor(const Descriptor&) = delete;
+            Descriptor& operator=(const Descriptor&) = delete;
+        };
+
+        const CLAB& _parser;
+        String _path;
+        String _name;
+        Descriptor _watch;
+        Evaluation _current;
+
+        static inline String name_of(const String& path) {
+            size_t slash = path.rfind('/');
+            return slash == String::npos ? path : path.substr(slash + 1);
+        }
+
+        /* Watches the parent directory of `path`: editors that replace the file are seen too. */
+        static inline int watch(const String& path) {
+            size_t slash = path.rfind('/');
+            String dir = slash == String::npos ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+
+            int fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            if(fd < 0 || ::inotify_add_watch(fd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+                if(fd >= 0)
+                    ::close(fd);
+                throw Exception("Cannot watch argument file '" + path + "'.");
+            }
+            return fd;
+        }
+
+        inline bool drain() {
+            alignas(struct inotify_event) char buffer[4096];
+            bool touched = false;
+
+            for(;;) {
+                ssize_t len = ::read(_watch.fd, buffer, sizeof(buffer));
+                if(len <= 0)
+                    return touched;
+
+                for(ssize_t off = 0; off < len;) {
+                    const struct inotify_event* ev = reinterpret_cast<const struct inotify_event*>(buffer + off);
+                    if(ev->len > 0 && _name == ev->name)
+                        touched = true;
+                    off += static_cast<ssize_t>(sizeof(struct inotify_event) + ev->len);
+                }
+            }
+        }
+
+    public:
+        /*
+        ** @brief Starts watching `path`, then parses it once.
+        ** @note The watch comes first, so a write during the first parse is reported by the next `poll`.
+        ** @note Only finished writes (`IN_CLOSE_WRITE`) and files renamed into place (`IN_MOVED_TO`)
+        **       count as changes, never a file still being written.
+        ** @throws Exception if inotify is unavailable, or any parse error of the first load.
+        */
+        ArgsFileWatcher(const CLAB& parser, String path)
+            : _parser(parser), _path(std::move(path)), _name(name_of(_path)), _watch(watch(_path)),
+              _current(_parser.evaluate(read_args_file(_path))) {}
+
+        ArgsFileWatcher(const ArgsFileWatcher&) = delete;
+        ArgsFileWatcher& operator=(const ArgsFileWatcher&) = delete;
+
+        /** @brief The last successful evaluation. */
+        inline const Evaluation& current() const noexcept {
+            return _current;
+        }
+
+        /** @brief inotify descriptor, readable when the file may have changed (for external poll loops). */
+        inline int fd() const noexcept {
+            return _watch.fd;
+        }
+
+        /*
+        ** @brief Re-parses the file now (e.g. on SIGHUP) and returns what changed.
+        ** @note On a parse error the exception propagates and `current()` is kept.
+        */
+        inline Vector<Evaluation::Change> reload() {
+            Evaluation next = _parser.evaluate(read_args_file(_path));
+            Vector<Evaluation::Change> changes = _current.diff(next);
+            _current = std::move(next);
+            return changes;
+        }
+
+        /*
+        ** @brief Waits up to `timeout_ms` (-1 = forever) for the file to change, then reloads it.
+        ** @return The changed flags; empty on timeout or when the new contents parse the same.
+        */
+        inline Vector<Evaluation::Change> poll(int timeout_ms = -1) {
+            struct pollfd pfd{ _watch.fd, POLLIN, 0 };
+            int ready = ::poll(&pfd, 1, timeout_ms);
+            if(ready <= 0 || !drain())
+                return {};
+            return reload();
+        }
+    };
+
+#endif // __linux__
+
+} // namespace clab
@@ -0,0 +1,132 @@
+/*---------------------------------------------------------------*\
+| CLAB - Command Line Arguments Builder                           |
+|                                                                 |
+| File: allocations.cpp                                           |
+| Description:                                                    |
+|     Allocation budgets of the parse paths, counted with         |
+|     details/alloc.hpp. Fails when a fixed scenario allocates    |
+|     more than its budget, or when a reused evaluation (or       |
+|     event parser) allocates at all once warmed up.              |
+|                                                                 |
+| Minimum Standard: ISO C++17                                     |
+| License: MIT (c) 2025                                           |
+\*---------------------------------------------------------------*/
+
+#define CLAB_COUNT_ALLOCATIONS
+#include <cstdio>
+#include "../details/alloc.hpp"
+#include "../clab.hpp"
+#include "../details/fixed.hpp"
+
+namespace {
+
+    int failures = 0;
+
+    void expect_at_most(const char* scenario, const clab::AllocationCounts& counts, uint64_t budget) {
+        bool ok = counts.allocations <= budget;
+        std::printf("%-4s %-48s %4llu allocations (budget %llu)\n", ok ? "ok" : "FAIL", scenario,
+            static_cast<unsigned long long>(counts.allocations), static_cast<unsigned long long>(budget));
+        failures += ok ? 0 : 1;
+    }
+
+    /* `flags` tagged flags `-f<i>`, every third taking a value, plus a multiple positional. */
+    clab::CLAB make_schema(size_t flags, bool finalize) {
+        clab::CLAB parser;
+        for(size_t i = 0; i < flags; ++i)
+            parser.start("flag_" + std::to_string(i)).flag("f" + std::to_string(i)).consume(i % 3 == 0 ? 1 : 0).end();
+        parser.start("files").multiple().end();
+        if(finalize)
+            parser.finalize();
+        return parser;
+    }
+
+    /* Ten tagged flags spread over the schema, the values of the ones that take one, and two files. */
+    clab::Vector<clab::String> make_args(size_t flags) {
+        clab::Vector<clab::String> args;
+        for(size_t i = 0; i < flags; i += flags / 10 > 0 ? flags / 10 : 1) {
+            args.push_back("-f" + std::to_string(i));
+            if(i % 3 == 0)
+                args.push_back("value_" + std::to_string(i));
+        }
+        args.push_back("a.txt");
+        args.push_back("b.txt");
+        return args;
+    }
+
+    /* Fresh and reused `evaluate` at one schema size. */
+    void check_evaluate(size_t flags, bool finalize, uint64_t fresh_budget) {
+        const clab::CLAB parser = make_schema(flags, finalize);
+        const clab::Vector<clab::String> args = make_args(flags);
+        const clab::String label = std::to_string(flags + 1) + " ids" + (finalize ? ", finalized" : "");
+
+        expect_at_most(("evaluate(args), " + label).c_str(),
+            clab::allocations_of([&] { clab::Evaluation eval = parser.evaluate(args); }), fresh_budget);
+
+        clab::Evaluation eval;
+        parser.evaluate(args, eval); // warm up
+        expect_at_most(("evaluate(args, out) reused, " + label).c_str(),
+            clab::allocations_of([&] { parser.evaluate(args, eval); }), 0);
+    }
+
+    /* `events()` and a reused `Events` at one schema size. */
+    void check_events(size_t flags, uint64_t fresh_budget) {
+        const clab::CLAB parser = make_schema(flags, true);
+        const clab::Vector<clab::String> args = make_args(flags);
+        const clab::String label = std::to_string(flags + 1) + " ids";
+        size_t seen = 0;
+
+        expect_at_most(("events(args), " + label).c_str(), clab::allocations_of([&] {
+            for(const clab::Event& ev : parser.events(args))
+                seen += ev.flag;
+        }), fresh_budget);
+
+        clab::CLAB::Events events = parser.events(args);
+        for(const clab::Event& ev : events) // warm up
+            seen += ev.flag;
+        expect_at_most(("Events::reset reused, " + label).c_str(), clab::allocations_of([&] {
+            events.reset(clab::TokenView(args));
+            for(const clab::Event& ev : events)
+                seen += ev.flag;
+        }), 0);
+        if(seen == 0)
+            std::printf("no events\n");
+    }
+
+} // namespace
+
+int main() {
+    // budgets of a fresh evaluation: slots, value pool, value lists, and the seen-set beyond 256 ids
+    check_evaluate(10, false, 8);
+    check_evaluate(10, true, 8);
+    check_evaluate(300, true, 15);
+    check_evaluate(2000, true, 9);
+
+    check_events(10, 0);
+    check_events(300, 1);
+    check_events(2000, 1);
+
+    {
+        clab::CLAB parser = make_schema(300, true);
+        parser.record_order().intern_values();
+        const clab::Vector<clab::String> args = make_args(300);
+        clab::Evaluation eval;
+        parser.evaluate(args, eval);
+        expect_at_most("evaluate(args, out) reused, order + interned", clab::allocations_of([&] { parser.evaluate(args, eval); }), 0);
+    }
+
+    {
+        clab::FixedCLAB<16, 16, 32, 512> fixed;
+        fixed.start("input").flag("i").consume(1).end();
+        fixed.start("verbose").flag("v").end();
+        fixed.start("files").multiple().end();
+        const clab::Vector<clab::String> args = { "-i", "in.txt", "-v", "a.txt", "b.txt" };
+        clab::FixedCLAB<16, 16, 32, 512>::Evaluation eval;
+        expect_at_most("FixedCLAB::evaluate", clab::allocations_of([&] { fixed.evaluate(args, eval); }), 0);
+    }
+
+    if(failures > 0) {
+        std::printf("%d allocation budget(s) exceeded\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,38 @@
+/*---------------------------------------------------------------*\
+| CLAB - Command Line Arguments Builder                           |
+|                                                                 |
+| File: codegen_check.cpp                                         |
+| Description:                                                    |
+|     Second half of the generated parser test: compiles every    |
+|     parser written by codegen_gen and compares it with          |
+|     `CLAB::evaluate` on the inputs of its case.                 |
+|                                                                 |
+| Minimum Standard: ISO C++17                                     |
+| License: MIT (c) 2025                                           |
+\*---------------------------------------------------------------*/
+
+#include <cstdio>
+#include "../details/differential.hpp"
+#include "cases.hpp" // written by codegen_gen
+
+int main() {
+    clab::Differential differential;
+    size_t cases = 0;
+    clab::String mismatch;
+
+    codegen_cases::for_each([&](size_t c, auto parse) {
+        if(!mismatch.empty())
+            return;
+        mismatch = differential.check_generated(c, codegen_cases::seed, parse);
+        if(!mismatch.empty())
+            mismatch = "case " + std::to_string(c) + ": " + mismatch;
+        cases++;
+    });
+
+    if(!mismatch.empty()) {
+        std::fprintf(stderr, "%s\n", mismatch.c_str());
+        return 1;
+    }
+    std::printf("generated parsers match evaluate on %zu cases\n", cases);
+    return 0;
+}
@@ -0,0 +1,69 @@
+/*---------------------------------------------------------------*\
+| CLAB - Command Line Arguments Builder                           |
+|                                                                 |
+| File: codegen_gen.cpp                                           |
+| Description:                                                    |
+|     First half of the generated parser test: writes a parser    |
+|     with `ParserGenerator` for a fixed set of `Differential`    |
+|     schemas, plus `cases.hpp` listing them for codegen_check.   |
+|                                                                 |
+| Minimum Standard: ISO C++17                                     |
+| License: MIT (c) 2025                                           |
+\*---------------------------------------------------------------*/
+
+#include <cstdio>
+#include <fstream>
+#include "../details/codegen.hpp"
+#include "../details/differential.hpp"
+
+namespace {
+
+    constexpr size_t case_count = 100;
+    constexpr uint64_t case_seed = 66;
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if(argc != 2) {
+        std::fprintf(stderr, "usage: %s <output dir>\n", argv[0]);
+        return 2;
+    }
+    const clab::String dir = argv[1];
+
+    clab::Differential differential;
+    clab::Vector<size_t> written;
+    for(size_t c = 0; c < case_count; ++c) {
+        clab::CLAB schema;
+        if(!differential.schema(c, case_seed, schema))
+            continue;
+
+        clab::ParserGenerator::Options options;
+        options.name_space = "case_" + std::to_string(c);
+        if(!clab::ParserGenerator::write_file(schema, dir + "/case_" + std::to_string(c) + ".hpp", options)) {
+            std::fprintf(stderr, "cannot write to %s\n", dir.c_str());
+            return 1;
+        }
+        written.push_back(c);
+    }
+
+    std::ofstream out(dir + "/cases.hpp");
+    out << "// Generated by codegen_gen. Do not edit.\n"
+        << "#pragma once\n\n"
+        << "#include <cstdint>\n"
+        << "#include <string>\n"
+        << "#include <vector>\n";
+    for(size_t c : written)
+        out << "#include \"case_" << c << ".hpp\"\n";
+    out << "\nnamespace codegen_cases {\n\n"
+        << "    constexpr std::uint64_t seed = " << case_seed << ";\n\n"
+        << "    /* Calls `fn(case, parse)` for every generated case. */\n"
+        << "    template<class Fn>\n"
+        << "    void for_each(Fn&& fn) {\n";
+    for(size_t c : written)
+        out << "        fn(" << c << ", [](const std::vector<std::string>& args) { return case_" << c << "::parse(args); });\n";
+    out << "    }\n\n"
+        << "} // namespace codegen_cases\n";
+
+    std::printf("generated %zu of %zu cases\n", written.size(), case_count);
+    return out ? 0 : 1;
+}
@@ -0,0 +1,50 @@
+/*---------------------------------------------------------------*\
+| CLAB - Command Line Arguments Builder                           |
+|                                                                 |
+| File: compile_bench.cpp                                         |
+| Description:                                                    |
+|     A typical TU using clab: builds a schema and calls          |
+|     `evaluate`. Only compiled, by `make compile-bench`, to      |
+|     compare compile time and object size of the header-only    |
+|     and the compiled (CLAB_COMPILED) modes.                     |
+|                                                                 |
+| Minimum Standard: ISO C++17                                     |
+| License: MIT (c) 2025                                           |
+\*---------------------------------------------------------------*/
+
+#include "../clab.hpp"
+
+clab::String compile_bench_input(int argc, char* argv[]) {
+    clab::CLAB builder;
+    builder
+        .start("input")
+            .flag("i")
+            .flag("input", "--")
+            .consume(1)
+            .required()
+        .end()
+        .start("output")
+            .flag("o")
+            .consume(1)
+            .initial("a.out")
+        .end()
+        .start("level")
+            .flag("l")
+            .consume(1, { "debug", "info", "warn" })
+        .end()
+        .start("verbose")
+            .flag("v")
+            .toggle(false, "q")
+        .end()
+        .start("files")
+            .multiple()
+        .end()
+        .start("help")
+            .flag("h")
+            .abort()
+        .end()
+        .finalize();
+
+    clab::Evaluation eval = builder.evaluate(argc, argv);
+    return eval.aborted() ? clab::String() : eval.value("input");
+}
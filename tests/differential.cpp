@@ -0,0 +1,38 @@
+/*---------------------------------------------------------------*\
+| CLAB - Command Line Arguments Builder                           |
+|                                                                 |
+| File: differential.cpp                                          |
+| Description:                                                    |
+|     Runs `Differential::check` on a fixed seed and case count,  |
+|     comparing every engine with the plain `evaluate`.           |
+|                                                                 |
+| Minimum Standard: ISO C++17                                     |
+| License: MIT (c) 2025                                           |
+\*---------------------------------------------------------------*/
+
+#include <cstdio>
+#include "../details/differential.hpp"
+
+namespace {
+
+    constexpr size_t case_count = 5000;
+    constexpr uint64_t case_seed = 1;
+
+} // namespace
+
+int main() {
+    clab::Differential differential;
+    size_t indexed = 0;
+    for(size_t c = 0; c < case_count; ++c) {
+        clab::CLAB schema;
+        indexed += differential.schema(c, case_seed, schema) ? 1 : 0;
+    }
+
+    clab::String mismatch = differential.check(case_count, case_seed);
+    if(!mismatch.empty()) {
+        std::fprintf(stderr, "%s\n", mismatch.c_str());
+        return 1;
+    }
+    std::printf("every engine matches evaluate on %zu cases (%zu finalized)\n", case_count, indexed);
+    return 0;
+}
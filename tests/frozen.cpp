@@ -0,0 +1,60 @@
+/*---------------------------------------------------------------*\
+| CLAB - Command Line Arguments Builder                           |
+|                                                                 |
+| File: frozen.cpp                                                |
+| Description:                                                    |
+|     Every `FlagConfigurator` method must throw `InvalidBuilding`|
+|     on a finalized builder, even through a configurator kept    |
+|     from before `finalize()`, and leave the schema unchanged.   |
+|                                                                 |
+| Minimum Standard: ISO C++17                                     |
+| License: MIT (c) 2025                                           |
+\*---------------------------------------------------------------*/
+
+#include <cstdio>
+#include <functional>
+#include "../clab.hpp"
+
+namespace {
+
+    using Configurator = clab::CLAB::FlagConfigurator;
+
+    int failures = 0;
+
+    void expect_throws(const char* method, const std::function<void(Configurator&)>& call) {
+        clab::CLAB parser;
+        Configurator kept = parser.start("input");
+        kept.flag("i").consume(1);
+        parser.finalize();
+
+        bool thrown = false;
+        try {
+            call(kept);
+        } catch(const clab::InvalidBuilding&) {
+            thrown = true;
+        }
+        clab::Evaluation eval = parser.evaluate({ "-i", "in.txt" });
+        bool unchanged = eval.value("input") == "in.txt" && !eval.state("x");
+
+        bool ok = thrown && unchanged;
+        std::printf("%-4s %s\n", ok ? "ok" : "FAIL", method);
+        failures += ok ? 0 : 1;
+    }
+
+} // namespace
+
+int main() {
+    expect_throws("action", [](Configurator& c) { c.action([](const clab::String&) {}); });
+    expect_throws("flag", [](Configurator& c) { c.flag("x"); });
+    expect_throws("toggle", [](Configurator& c) { c.toggle(false, "x"); });
+    expect_throws("initial(bool)", [](Configurator& c) { c.initial(true); });
+    expect_throws("initial(String)", [](Configurator& c) { c.initial(clab::String("d")); });
+    expect_throws("initial(list)", [](Configurator& c) { c.initial({ "d", "e" }); });
+    expect_throws("consume", [](Configurator& c) { c.consume(0); });
+    expect_throws("consume(allowed)", [](Configurator& c) { c.consume(1, { "a" }); });
+    expect_throws("required", [](Configurator& c) { c.required(); });
+    expect_throws("multiple", [](Configurator& c) { c.multiple(); });
+    expect_throws("abort", [](Configurator& c) { c.abort(); });
+    expect_throws("over", [](Configurator& c) { c.over(); });
+    return failures == 0 ? 0 : 1;
+}
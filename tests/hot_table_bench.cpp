@@ -0,0 +1,155 @@
+/*---------------------------------------------------------------*\
+| CLAB - Command Line Arguments Builder                           |
+|                                                                 |
+| File: hot_table_bench.cpp                                       |
+| Description:                                                    |
+|     Benchmark of the hot table (user-061). Reports ns, cycles   |
+|     and cache misses of `evaluate` on a large schema, on the    |
+|     inputs that walk the flag table: tagged tokens, positional  |
+|     runs and the per-parse defaults and required passes. Then   |
+|     the same parses per phase through `PerfMetrics`. Needs perf |
+|     events for counters; prints timings otherwise.              |
+|                                                                 |
+| Minimum Standard: ISO C++17                                     |
+| License: MIT (c) 2025                                           |
+\*---------------------------------------------------------------*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include "../clab.hpp"
+#include "../details/perf.hpp"
+
+namespace {
+
+    using clab::CLAB;
+    using clab::PerfCounters;
+    using clab::PerfEvent;
+    using Clock = std::chrono::steady_clock;
+
+    constexpr int runs = 20;
+
+    /*
+    ** `flags` flags: every fourth positional, every third consuming a value with a default,
+    ** every thirtieth tagged one required and every fifth tagged one multiple. Tags and
+    ** defaults allocate between flags like a real builder does.
+    */
+    CLAB make_schema(size_t flags) {
+        CLAB parser;
+        for(size_t i = 0; i < flags; ++i) {
+            CLAB::FlagConfigurator f = parser.start("flag_" + std::to_string(i));
+            if(i % 4 != 0)
+                f.flag("f" + std::to_string(i));
+            f.consume(i % 3 == 0 ? 1 : 0);
+            if(i % 30 == 1)
+                f.required();
+            if(i % 3 == 0)
+                f.initial("default_value_" + std::to_string(i));
+            if(i % 5 == 0 && i % 4 != 0)
+                f.multiple();
+            f.end();
+        }
+        parser.finalize();
+        return parser;
+    }
+
+    /* The tag of every required flag. */
+    clab::Vector<clab::String> required_args(size_t flags) {
+        clab::Vector<clab::String> args;
+        for(size_t i = 1; i < flags; i += 30)
+            args.push_back("-f" + std::to_string(i));
+        return args;
+    }
+
+    /* The required tags, then each other tagged flag at most once in a scattered order (7919 is prime). */
+    clab::Vector<clab::String> tagged_args(size_t flags, size_t tokens) {
+        clab::Vector<clab::String> args = required_args(flags);
+        for(size_t n = 0, i = 0; n < flags && args.size() < tokens; ++n, i = (i + 7919) % flags) {
+            if(i % 4 == 0 || i % 30 == 1)
+                continue;
+            args.push_back("-f" + std::to_string(i));
+            if(i % 3 == 0)
+                args.push_back("value");
+        }
+        return args;
+    }
+
+    /* The required tags, then one word per positional: each moves the positional scan on to the next flag. */
+    clab::Vector<clab::String> positional_args(size_t flags, size_t tokens) {
+        clab::Vector<clab::String> args = required_args(flags);
+        for(size_t i = 0; i < flags && args.size() < tokens; i += 4)
+            args.push_back("word");
+        return args;
+    }
+
+    struct Result {
+        double ns = 0;
+        double counters[PerfCounters::count] = {};
+    };
+
+    /* `runs` parses of `args` after one warm-up parse, per token. */
+    Result measure(const PerfCounters& counters, const CLAB& parser, const clab::Vector<clab::String>& args) {
+        clab::Evaluation eval;
+        parser.evaluate(args, eval); // throws if the inputs above stop matching the schema
+
+        PerfCounters::Sample before, after;
+        counters.read(before);
+        Clock::time_point start = Clock::now();
+        for(int r = 0; r < runs; ++r)
+            parser.evaluate(args, eval);
+        double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+        counters.read(after);
+
+        double per = static_cast<double>(runs) * static_cast<double>(args.size());
+        Result r;
+        r.ns = ns / per;
+        for(size_t e = 0; e < PerfCounters::count; ++e)
+            r.counters[e] = static_cast<double>(after[e] - before[e]) / per;
+        return r;
+    }
+
+    void print(const char* name, const Result& r, const PerfCounters& counters) {
+        std::printf("%-14s %10.1f", name, r.ns);
+        for(size_t e = 0; e < PerfCounters::count; ++e) {
+            if(counters.available(static_cast<PerfEvent>(e)))
+                std::printf(" %14.2f", r.counters[e]);
+        }
+        std::printf("\n");
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t flags = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000;
+    size_t tokens = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 2000;
+
+    PerfCounters counters;
+    if(!counters.available())
+        std::printf("# perf events unavailable, timings only\n");
+
+    const CLAB parser = make_schema(flags);
+    const clab::Vector<clab::String> tagged = tagged_args(flags, tokens);
+    const clab::Vector<clab::String> positional = positional_args(flags, tokens);
+
+    // 1. Whole parses, per token: the defaults and required passes cover every flag once per parse.
+    std::printf("# evaluate, %zu flags, %d runs, per token\ninput            ns/token", flags, runs);
+    for(size_t e = 0; e < PerfCounters::count; ++e) {
+        if(counters.available(static_cast<PerfEvent>(e)))
+            std::printf(" %14s", (std::string(clab::perf_event_name(static_cast<PerfEvent>(e))) + "/tok").c_str());
+    }
+    std::printf("\n");
+
+    print("tagged", measure(counters, parser, tagged), counters);
+    print("positional", measure(counters, parser, positional), counters);
+
+    // 2. The same parses per phase.
+    for(const clab::Vector<clab::String>* args : { &tagged, &positional }) {
+        clab::PerfMetrics metrics;
+        for(int r = 0; r < runs; ++r)
+            parser.evaluate(*args, metrics);
+        std::printf("\n# %s, %zu tokens x %d\n", args == &tagged ? "tagged" : "positional", args->size(), runs);
+        metrics.write_report(std::cout, args->size() * runs);
+    }
+    return 0;
+}
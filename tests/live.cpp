@@ -0,0 +1,148 @@
+/*---------------------------------------------------------------*\
+| CLAB - Command Line Arguments Builder                           |
+|                                                                 |
+| File: live.cpp                                                  |
+| Description:                                                    |
+|     Concurrent readers and writers on a `LiveCLAB`: readers     |
+|     must always parse a complete version and never go back to   |
+|     an older one, and no concurrent `update` may be lost.       |
+|     Build with -fsanitize=thread to check the reclamation too.  |
+|                                                                 |
+| Minimum Standard: ISO C++17                                     |
+| License: MIT (c) 2025                                           |
+\*---------------------------------------------------------------*/
+
+#include <atomic>
+#include <cstdio>
+#include <stdexcept>
+#include <thread>
+#include "../details/live.hpp"
+
+namespace {
+
+    constexpr int reader_count = 4;
+    constexpr int writer_count = 3;
+    constexpr int updates_per_writer = 100;
+    constexpr int publishes = 200;
+
+    std::atomic<int> failures{0};
+
+    void fail(const char* what) {
+        if(failures++ == 0)
+            std::printf("FAIL %s\n", what);
+    }
+
+    size_t flag_count(const clab::CLAB& parser) {
+        size_t n = 0;
+        try {
+            for(;; ++n)
+                parser.id_of(n);
+        } catch(const std::out_of_range&) {
+        }
+        return n;
+    }
+
+    /* Runs `readers` threads calling `read(eval)` in a loop while `write()` runs, then joins them. */
+    template<class Read, class Write>
+    void race(Read read, Write write) {
+        std::atomic<bool> done{false};
+        std::vector<std::thread> readers;
+        for(int r = 0; r < reader_count; ++r) {
+            readers.emplace_back([&] {
+                clab::Evaluation eval;
+                while(!done.load())
+                    read(eval);
+            });
+        }
+        write();
+        done = true;
+        for(std::thread& t : readers)
+            t.join();
+    }
+
+} // namespace
+
+int main() {
+    const clab::Vector<clab::String> args = { "-i", "in.txt" };
+
+    // 1. concurrent updates: each adds one flag, readers see the count only grow
+    {
+        clab::CLAB initial;
+        initial.start("input").flag("i").consume(1).end();
+        clab::LiveCLAB live(std::move(initial));
+
+        race([&](clab::Evaluation& eval) {
+            thread_local size_t last = 0;
+            clab::LiveCLAB::Snapshot version = live.snapshot();
+            version->evaluate(args, eval);
+            size_t flags = flag_count(*version);
+            if(eval.value("input") != "in.txt")
+                fail("reader parsed a broken version");
+            if(flags < last)
+                fail("reader went back to an older version");
+            last = flags;
+        }, [&] {
+            std::vector<std::thread> writers;
+            for(int w = 0; w < writer_count; ++w) {
+                writers.emplace_back([&, w] {
+                    for(int i = 0; i < updates_per_writer; ++i) {
+                        clab::String id = "u" + std::to_string(w) + "_" + std::to_string(i);
+                        live.update([&](clab::CLAB& next) { next.start(id).flag(id).end(); });
+                    }
+                });
+            }
+            for(std::thread& t : writers)
+                t.join();
+        });
+
+        if(flag_count(*live.snapshot()) != 1 + writer_count * updates_per_writer)
+            fail("an update was lost");
+    }
+
+    // 2. publish racing update: every version is whole, and updates made after a publish stay
+    {
+        clab::LiveCLAB live;
+        std::atomic<int> updates{0};
+
+        race([&](clab::Evaluation& eval) {
+            clab::LiveCLAB::Snapshot version = live.snapshot();
+            size_t flags = flag_count(*version);
+            if(flags == 0)
+                return;
+            version->evaluate({}, eval);
+            // published versions declare `size` first, with their flag count (updates add one each)
+            size_t declared = std::stoul(eval.value("size"));
+            if(flags < declared)
+                fail("reader parsed a partial version");
+        }, [&] {
+            std::thread updater([&] {
+                for(int i = 0; i < publishes; ++i) {
+                    live.update([&](clab::CLAB& next) {
+                        if(flag_count(next) > 0)
+                            next.start("extra_" + std::to_string(i)).end();
+                    });
+                    updates++;
+                }
+            });
+            for(int i = 0; i < publishes; ++i) {
+                clab::CLAB next;
+                size_t n = 1 + static_cast<size_t>(i % 7);
+                next.start("size").consume(1).initial(std::to_string(n)).end();
+                for(size_t f = 1; f < n; ++f)
+                    next.start("f" + std::to_string(f)).flag("f" + std::to_string(f)).end();
+                live.publish(std::move(next));
+            }
+            updater.join();
+        });
+
+        size_t before = flag_count(*live.snapshot());
+        live.update([](clab::CLAB& next) { next.start("last").end(); });
+        if(flag_count(*live.snapshot()) != before + 1)
+            fail("an update after publish was lost");
+    }
+
+    if(failures.load() > 0)
+        return 1;
+    std::printf("live versions consistent under %d readers\n", reader_count);
+    return 0;
+}
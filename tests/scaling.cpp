@@ -0,0 +1,175 @@
+/*---------------------------------------------------------------*\
+| CLAB - Command Line Arguments Builder                           |
+|                                                                 |
+| File: scaling.cpp                                               |
+| Description:                                                    |
+|     Complexity regression test. Sweeps argv size and schema     |
+|     size, fits the growth exponent of `evaluate` on a log-log   |
+|     scale and fails when it grows worse than O(n log n) in      |
+|     tokens or super-linearly in flags per token. Wall-clock     |
+|     based, so it runs from `make stress`, not `make check`.     |
+|                                                                 |
+| Minimum Standard: ISO C++17                                     |
+| License: MIT (c) 2025                                           |
+\*---------------------------------------------------------------*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include "../clab.hpp"
+#include "../details/fixed.hpp"
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    /*
+    ** Highest exponent accepted. n log n over the sweeps below fits about 1.1, linear 1.0 and
+    ** quadratic 2.0; the margin absorbs timer noise.
+    */
+    constexpr double max_exponent = 1.35;
+    constexpr int repeats = 15;
+    // the smallest sizes are measured and printed but not fitted: fixed costs and noise dominate them
+    constexpr size_t unfitted_points = 2;
+
+    int failures = 0;
+
+    struct Point {
+        double n;
+        double ns;
+    };
+
+    /* Best of `repeats` runs of `parse` after one warm-up run, in nanoseconds. */
+    template<class Parse>
+    double best_of(Parse&& parse) {
+        parse();
+        double best = 0;
+        for(int r = 0; r < repeats; ++r) {
+            Clock::time_point start = Clock::now();
+            parse();
+            double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+            best = r == 0 ? ns : std::min(best, ns);
+        }
+        return best;
+    }
+
+    /* Best of `repeats` reused parses, in nanoseconds. */
+    double time_parse(const clab::CLAB& parser, const clab::Vector<clab::String>& args) {
+        clab::Evaluation eval;
+        return best_of([&] { parser.evaluate(args, eval); });
+    }
+
+    /* Least squares slope of log(ns) over log(n). */
+    double exponent(const clab::Vector<Point>& points) {
+        double sx = 0, sy = 0, sxx = 0, sxy = 0;
+        for(const Point& p : points) {
+            double x = std::log(p.n), y = std::log(p.ns);
+            sx += x;
+            sy += y;
+            sxx += x * x;
+            sxy += x * y;
+        }
+        double k = static_cast<double>(points.size());
+        return (k * sxy - sx * sy) / (k * sxx - sx * sx);
+    }
+
+    /*
+    ** Runs `parse_ns(n)` for n = first, 2 first, ... last and checks the exponent fitted on the
+    ** larger sizes. A sweep over the limit is measured once more, so one noisy run doesn't fail it.
+    */
+    void sweep(const char* name, const char* unit, size_t first, size_t last, const std::function<double(size_t)>& parse_ns) {
+        double k = 0;
+        for(int attempt = 0; attempt < 2 && (attempt == 0 || k > max_exponent); ++attempt) {
+            clab::Vector<Point> points;
+            std::printf("%s%s\n", name, attempt ? " (again)" : "");
+            for(size_t n = first; n <= last; n *= 2) {
+                double ns = parse_ns(n);
+                points.push_back({ static_cast<double>(n), ns });
+                std::printf("    n = %6zu  %12.0f %s\n", n, ns, unit);
+            }
+            points.erase(points.begin(), points.begin() + static_cast<std::ptrdiff_t>(std::min(unfitted_points, points.size() - 2)));
+            k = exponent(points);
+        }
+
+        bool ok = k <= max_exponent;
+        std::printf("%s exponent %.2f (max %.2f)\n\n", ok ? "ok  " : "FAIL", k, max_exponent);
+        failures += ok ? 0 : 1;
+    }
+
+    /* `flags` tagged flags, every third consuming a value, plus a multiple positional. */
+    clab::CLAB tagged_schema(size_t flags, bool finalize) {
+        clab::CLAB parser;
+        for(size_t i = 0; i < flags; ++i)
+            parser.start("flag_" + std::to_string(i)).flag("f" + std::to_string(i)).consume(i % 3 == 0 ? 1 : 0).multiple().end();
+        parser.start("files").multiple().end();
+        if(finalize)
+            parser.finalize();
+        return parser;
+    }
+
+    /* About `tokens` tokens: tags spread over the schema, their values, and runs of positional words. */
+    clab::Vector<clab::String> tagged_args(size_t flags, size_t tokens) {
+        clab::Vector<clab::String> args;
+        for(size_t i = 0; args.size() < tokens; i = (i + 7919) % flags) {
+            args.push_back("-f" + std::to_string(i));
+            if(i % 3 == 0)
+                args.push_back("value");
+            if(i % 5 == 0) {
+                args.push_back("word_a");
+                args.push_back("word_b");
+            }
+        }
+        return args;
+    }
+
+} // namespace
+
+int main() {
+    // 1. argv size: a fixed schema, growing input
+    const clab::CLAB hundred = tagged_schema(100, true);
+    sweep("tokens (100 flags, finalized): ns per parse", "ns", 1024, 65536, [&](size_t n) {
+        return time_parse(hundred, tagged_args(100, n));
+    });
+
+    // 2. schema size: a fixed input, growing schema, per token; the linear scan is the worst case
+    for(bool finalize : { true, false }) {
+        sweep(finalize ? "flags (1024 tokens, finalized): ns per token" : "flags (1024 tokens, linear scan): ns per token",
+            "ns/token", 256, 8192, [&](size_t n) {
+                clab::Vector<clab::String> args = tagged_args(n, 1024);
+                return time_parse(tagged_schema(n, finalize), args) / static_cast<double>(args.size());
+            });
+    }
+
+    // 3. both: n positionals filled by n values, each run picking the next positional
+    sweep("positionals (n flags, n tokens): ns per parse", "ns", 512, 16384, [](size_t n) {
+        clab::CLAB parser;
+        for(size_t i = 0; i < n; ++i)
+            parser.start("pos_" + std::to_string(i)).consume(1).end();
+        parser.finalize();
+        return time_parse(parser, clab::Vector<clab::String>(n, "value"));
+    });
+
+    // 4. the same for FixedCLAB, which keeps its own positional scan
+    sweep("fixed positionals (n flags, n tokens): ns per parse", "ns", 128, 4096, [](size_t n) {
+        using Fixed = clab::FixedCLAB<4096, 16, 4096, 65536>;
+        std::unique_ptr<Fixed> parser = std::make_unique<Fixed>();
+        for(size_t i = 0; i < n; ++i)
+            parser->start("pos_" + std::to_string(i)).consume(1).end();
+        std::unique_ptr<Fixed::Evaluation> eval = std::make_unique<Fixed::Evaluation>();
+        clab::Vector<clab::String> args(n, "value");
+        if(!parser->evaluate(args, *eval).ok()) {
+            std::printf("    FixedCLAB failed at n = %zu\n", n);
+            failures++;
+        }
+        return best_of([&] { parser->evaluate(args, *eval); });
+    });
+
+    if(failures > 0) {
+        std::printf("%d sweep(s) grew faster than allowed\n", failures);
+        return 1;
+    }
+    return 0;
+}